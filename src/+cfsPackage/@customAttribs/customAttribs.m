@@ -1,5 +1,8 @@
 classdef customAttribs < Simulink.CustomStorageClassAttributes
 	properties(PropertyType = 'char')
 		ValidationFcn = ''
+		% Alignment in bytes (power of two) of the data, or '' for the
+		% natural alignment of its type
+		Alignment = ''
 	end
 end % classdef
\ No newline at end of file
@@ -2,4 +2,39 @@ classdef customMsgAttribs < Simulink.CustomStorageClassAttributes
     properties(PropertyType = 'logical scalar')
         SupportSILPIL = true;
     end    
+    properties(PropertyType = 'char')
+        % Export-function models: name of the generated function-call
+        % entry point to run when this received message arrives.
+        EntryFunction = '';
+        % Sent telemetry: name of the aggregate container packet this
+        % message is packed into instead of being sent on its own.
+        Aggregate = '';
+        % Received commands: name of the uint32 root input set to the
+        % number of commands delivered this step.  The command input is
+        % then an array, filled with every command queued before the
+        % step instead of one per step.
+        BatchCount = '';
+        % Received telemetry: 'Latest' keeps only the last sample
+        % received before the step.  'Buffer' keeps every sample
+        % received since the last step in the input, an array, with
+        % the count in the uint32 root input named by SampleCount and
+        % the arrival times (s) in the double array root input named by
+        % SampleTimes (optional).
+        SamplePolicy = 'Latest';
+        SampleCount = '';
+        SampleTimes = '';
+        % Received commands: priority lane (0-255, higher is serviced
+        % first each step), or '' for the app command queue.  Commands
+        % of one Priority share a lane of LaneDepth commands (default
+        % ECI_CMD_MSG_QUEUE_SIZE); when it is full DropPolicy
+        % 'DropNewest' drops the received command, 'DropOldest' the
+        % oldest queued one.
+        Priority = '';
+        LaneDepth = '';
+        DropPolicy = 'DropNewest';
+        % Alignment in bytes (power of two) of the data, or '' for the
+        % natural alignment of its type.  Aligned message buses let the
+        % compiler use aligned vector loads in loops over their arrays.
+        Alignment = '';
+    end
 end % classdef
\ No newline at end of file
@@ -55,6 +55,16 @@ switch action
     set(h, 'DefineComment', '');
     set(h, 'CSCTypeAttributesClassName', 'cfsPackage.customMsgAttribs');
         set(h.CSCTypeAttributes, 'SupportSILPIL', true);
+        set(h.CSCTypeAttributes, 'EntryFunction', '');
+        set(h.CSCTypeAttributes, 'Aggregate', '');
+        set(h.CSCTypeAttributes, 'BatchCount', '');
+        set(h.CSCTypeAttributes, 'SamplePolicy', 'Latest');
+        set(h.CSCTypeAttributes, 'SampleCount', '');
+        set(h.CSCTypeAttributes, 'SampleTimes', '');
+        set(h.CSCTypeAttributes, 'Priority', '');
+        set(h.CSCTypeAttributes, 'LaneDepth', '');
+        set(h.CSCTypeAttributes, 'DropPolicy', 'DropNewest');
+        set(h.CSCTypeAttributes, 'Alignment', '');
     set(h, 'TLCFileName', 'cfsTlmMessage.tlc');
     defs = [defs; h];
 
@@ -90,6 +100,7 @@ switch action
     set(h, 'DefineComment', '');
     set(h, 'CSCTypeAttributesClassName', 'cfsPackage.customMsgAttribs');
         set(h.CSCTypeAttributes, 'SupportSILPIL', true);
+        set(h.CSCTypeAttributes, 'Alignment', '');
     set(h, 'TLCFileName', 'cfsCriticalDataStorage.tlc');
     defs = [defs; h];
 
@@ -125,6 +136,16 @@ switch action
     set(h, 'DefineComment', '');
     set(h, 'CSCTypeAttributesClassName', 'cfsPackage.customMsgAttribs');
         set(h.CSCTypeAttributes, 'SupportSILPIL', true);
+        set(h.CSCTypeAttributes, 'EntryFunction', '');
+        set(h.CSCTypeAttributes, 'Aggregate', '');
+        set(h.CSCTypeAttributes, 'BatchCount', '');
+        set(h.CSCTypeAttributes, 'SamplePolicy', 'Latest');
+        set(h.CSCTypeAttributes, 'SampleCount', '');
+        set(h.CSCTypeAttributes, 'SampleTimes', '');
+        set(h.CSCTypeAttributes, 'Priority', '');
+        set(h.CSCTypeAttributes, 'LaneDepth', '');
+        set(h.CSCTypeAttributes, 'DropPolicy', 'DropNewest');
+        set(h.CSCTypeAttributes, 'Alignment', '');
     set(h, 'TLCFileName', 'cfsCmdMessage.tlc');
     defs = [defs; h];
 
@@ -160,6 +181,7 @@ switch action
     set(h, 'DefineComment', '');
     set(h, 'CSCTypeAttributesClassName', 'cfsPackage.customAttribs');
         set(h.CSCTypeAttributes, 'ValidationFcn', '');
+        set(h.CSCTypeAttributes, 'Alignment', '');
     set(h, 'TLCFileName', 'cfsParmTable.tlc');
     defs = [defs; h];
 
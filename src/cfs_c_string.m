@@ -0,0 +1,22 @@
+%
+% Abstract: A helper function for the compact event table.  Returns the
+%           bytes of a uint8 string parameter (up to the first 0) as the
+%           body of a C string literal, so that cfs_interface.tlc can 
+%           intern the Event block format strings.  Quotes, backslashes 
+%           and non printable bytes are written as octal escapes.
+%    
+function str = cfs_c_string(bytes)
+    bytes = double(bytes(:)');
+    nul   = find(bytes == 0, 1);
+    if ~isempty(nul)
+        bytes = bytes(1:nul-1);
+    end
+    str = '';
+    for b = bytes
+        if b >= 32 && b < 127 && b ~= double('"') && b ~= double('\') && b ~= double('?')
+            str = [str char(b)]; %#ok<AGROW>
+        else
+            str = [str sprintf('\\%03o', b)]; %#ok<AGROW>
+        end
+    end
+end
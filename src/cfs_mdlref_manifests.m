@@ -0,0 +1,33 @@
+%
+% Abstract: A helper function for cfs_interface.tlc to locate the CFS
+%           interface manifests written by the code generation of each
+%           model referenced (at any level) by the top level model 'mdl'.
+%           A manifest (cfs_interface_manifest.tlc) is written into the
+%           model reference build folder of each referenced model built
+%           with the cfs_interface.tlc template. Referenced models which
+%           have no manifest (no CFS blocks or CFS storage classes, or
+%           protected models) are skipped.
+%
+%           Returns a cell array of full paths to the manifests, ordered
+%           from the bottom of the model hierarchy up.
+%
+function manifests = cfs_mdlref_manifests(mdl)
+    manifests = {};
+    manifestName = 'cfs_interface_manifest.tlc';
+
+    refs = find_mdlrefs(mdl, 'AllLevels', true, ...
+                        'IncludeProtectedModels', false);
+    for i = 1:numel(refs)
+        ref = refs{i};
+        if strcmp(ref, mdl)
+            continue;
+        end
+        buildDirs = RTW.getBuildDir(ref);
+        manifest  = fullfile(buildDirs.CodeGenFolder, ...
+                             buildDirs.ModelRefRelativeBuildDir, ...
+                             manifestName);
+        if exist(manifest, 'file') == 2
+            manifests{end+1} = manifest; %#ok<AGROW>
+        end
+    end
+end
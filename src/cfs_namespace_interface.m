@@ -0,0 +1,61 @@
+%
+% Abstract: A helper function to namespace the generated interface so 
+%           that several models can be included in one cFS app.  'buf' is
+%           the interface code from TLC and 'prefix' the model name.  
+%           Every file scope static table, function and typedef, and each
+%           ECI_TBL_FILEDEF object, is renamed <prefix>_<name>, and every
+%           macro the interface defines is undefined at the end so that 
+%           the next model's interface can define it again.  Macros that
+%           the interface only defines when not already defined 
+%           (#ifndef NAME) are left defined, and the names declared in 
+%           those blocks are shared by the interfaces and not renamed.  
+%           The interface defines no other file scope names: the ECI app 
+%           and model data it uses are declared extern, and the aggregate
+%           container types of <model>_tlm_aggregate.h are generated with
+%           the prefix (cfs_agg_type).
+%    
+function rbuf = cfs_namespace_interface(buf, prefix)
+    % Names declared in #ifndef blocks are shared by the interfaces
+    scoped = strjoin(unguardedLines(buf), newline);
+    names = [ regexp(scoped, '^\s*static\s+[^;=(\[\n]*?\<(\w+)\s*[\[=(;]', 'tokens', 'lineanchors'), ...
+              regexp(scoped, '^\s*}\s*(\w+)\s*;', 'tokens', 'lineanchors'), ...
+              regexp(scoped, '^\s*typedef\s[^{;\n]*?\<(\w+)\s*(?:\[[^;\n]*\])?\s*;', 'tokens', 'lineanchors'), ...
+              regexp(scoped, 'ECI_TBL_FILEDEF\(\s*(\w+)', 'tokens') ];
+    names = unique(cellfun(@(t) t{1}, names, 'UniformOutput', false));
+
+    rbuf = buf;
+    for i = 1:numel(names)
+        rbuf = regexprep(rbuf, ['(?<![\w.>"])' names{i} '\>'], [prefix '_' names{i}]);
+    end
+
+    macros  = regexp(buf, '^\s*#define\s+(\w+)', 'tokens', 'lineanchors');
+    guarded = regexp(buf, '^\s*#ifndef\s+(\w+)', 'tokens', 'lineanchors');
+    macros  = cellfun(@(t) t{1}, macros, 'UniformOutput', false);
+    guarded = cellfun(@(t) t{1}, guarded, 'UniformOutput', false);
+    macros  = setdiff(unique(macros, 'stable'), guarded, 'stable');
+
+    undefs = sprintf('#undef %s\n', macros{:});
+    rbuf   = sprintf('%s\n/* Interface macros of %s, see %s_ECI_Model */\n%s', ...
+                     rbuf, prefix, prefix, undefs);
+end
+
+% Lines of buf outside #ifndef blocks (and the #if blocks nested in them)
+function lines = unguardedLines(buf)
+    lines = strsplit(buf, newline);
+    keep  = true(size(lines));
+    depth = 0;
+    for i = 1:numel(lines)
+        if depth > 0
+            keep(i) = false;
+            if ~isempty(regexp(lines{i}, '^\s*#\s*if', 'once'))
+                depth = depth + 1;
+            elseif ~isempty(regexp(lines{i}, '^\s*#\s*endif', 'once'))
+                depth = depth - 1;
+            end
+        elseif ~isempty(regexp(lines{i}, '^\s*#\s*ifndef', 'once'))
+            keep(i) = false;
+            depth   = 1;
+        end
+    end
+    lines = lines(keep);
+end
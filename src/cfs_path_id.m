@@ -0,0 +1,15 @@
+%
+% Abstract: A helper function for the compact event table.  Returns the
+%           32 bit FNV-1a hash of a block path as a C constant, e.g. 
+%           '0x811C9DC5U'.  With hashed path IDs the ECI_Events loc field
+%           holds this ID, and <model>_eci_events.csv maps it back to the
+%           path on the ground.  Warm start uses it for the build ID
+%           of the CDS snapshot.
+%    
+function id = cfs_path_id(path)
+    h = uint64(2166136261);
+    for b = uint64(unicode2native(path, 'UTF-8'))
+        h = mod(bitxor(h, b) * uint64(16777619), uint64(4294967296));
+    end
+    id = sprintf('0x%08XU', h);
+end
@@ -0,0 +1,26 @@
+/**
+ * eci_host.h
+ *
+ *    ABSTRACT:
+ *      Host definitions of the ECI app services used by the generated
+ *      interface header.  Include before eci_interface.h.
+ *
+ */
+
+#ifndef ECI_HOST_H
+#define ECI_HOST_H
+
+#include <stdint.h>
+#include <time.h>
+
+/* Microsecond clock for the performance housekeeping step timer.  Inline,
+ * so includers that do not time steps get no unused function warning. */
+static inline uint32_t ECI_Host_TimeUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)ts.tv_sec * 1000000U + (uint32_t)(ts.tv_nsec / 1000L);
+}
+#define ECI_HK_TIME_US()   ECI_Host_TimeUs()
+
+#endif /* ECI_HOST_H */
@@ -0,0 +1,73 @@
+/**
+ * eci_host_rcv.h
+ *
+ *    ABSTRACT:
+ *      Delivery of received messages to a SIL generated model for the
+ *      host tools: commands with a priority are queued in their lane
+ *      (ECI_CmdLanes) and delivered by ECI_Host_StepBegin, commands of
+ *      batched inputs (ECI_CmdBatch) and samples of buffered telemetry
+ *      inputs (ECI_TlmSamples) are appended to their input arrays, other
+ *      messages copied to ECI_MsgRcv.  Include after eci_interface.h.
+ *
+ */
+
+#ifndef ECI_HOST_RCV_H
+#define ECI_HOST_RCV_H
+
+#include "eci_rec.h"
+
+/* Provided by the host tool */
+extern ECI_TimeStamp_t ECI_Step_TimeStamp;
+
+/* Function: ECI_Host_Deliver =============================================
+ * Abstract:
+ *   Delivers one received message, stamped with the step time.  Returns
+ *   0 when the MID is not received by the model.
+ */
+static int ECI_Host_Deliver(uint32_t mid, const void *msg, size_t size)
+{
+#ifdef ECI_CMD_LANES_DEFINED
+    if (ECI_CmdLaneAdd(mid, msg, size) != 0) {
+        return 1;
+    }
+#endif
+#ifdef ECI_CMD_BATCH_DEFINED
+    if (ECI_CmdBatchAdd(mid, msg, size) != 0) {
+        return 1;
+    }
+#endif
+#ifdef ECI_TLM_SAMPLES_DEFINED
+    if (ECI_TlmSampleAdd(mid, msg, size, (real_T)ECI_Step_TimeStamp.Seconds +
+                         (real_T)ECI_Step_TimeStamp.Subseconds / 4294967296.0) != 0) {
+        return 1;
+    }
+#endif
+    return ECI_Rec_Deliver(ECI_MsgRcv, mid, msg, size) != NULL;
+}
+
+/* Function: ECI_Host_StepBegin ===========================================
+ * Abstract:
+ *   Delivers the commands queued in the priority lanes, before the step.
+ */
+static void ECI_Host_StepBegin(void)
+{
+#ifdef ECI_CMD_LANES_DEFINED
+    ECI_CmdLaneService();
+#endif
+}
+
+/* Function: ECI_Host_StepDone ============================================
+ * Abstract:
+ *   Empties the command batches and telemetry buffers after the step.
+ */
+static void ECI_Host_StepDone(void)
+{
+#ifdef ECI_CMD_BATCH_DEFINED
+    ECI_CmdBatchClear();
+#endif
+#ifdef ECI_TLM_SAMPLES_DEFINED
+    ECI_TlmSampleClear();
+#endif
+}
+
+#endif /* ECI_HOST_RCV_H */
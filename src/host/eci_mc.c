@@ -0,0 +1,401 @@
+/**
+ * eci_mc.c
+ *
+ *    ABSTRACT:
+ *      Monte Carlo runner for a host build of one SIL generated model.
+ *      Each case is a directory of parameter table images; the runner
+ *      forks one process per case, up to the number of workers at a time,
+ *      so every case starts from the model's initial data.  A case loads
+ *      its images into the ECI_ParamTable pointers, runs ECI_INIT_FCN and
+ *      steps the model, optionally fed from a recorded message log
+ *      (eci_rec.h), writing the selected ECI_MsgSnd messages to columnar
+ *      result files.
+ *
+ *      Images are named after the table file of ECI_ParamTable
+ *      (<table>.tbl) and are either the raw table data or a cFE table
+ *      file, whose headers are skipped.  Tables with no image in the case
+ *      directory are loaded from the base directory (-b).
+ *
+ *      Results of each case go to <out dir>/<case name>/:
+ *        <MID>.bin    the message, msg size bytes per time it was sent
+ *        <MID>.time   ECI_Step_TimeStamp in seconds (double) per row
+ *      and <out dir>/cases.csv lists the exit status and run time of
+ *      each case.
+ *
+ *      Build against the generated code of one model, e.g.
+ *        gcc -O2 -I<model build dir> -I<eci_app.h dir> eci_mc.c \
+ *            eci_rec.c <model sources> -o <model>_mc -lm
+ *      leaving out the table definition files (<table>.c).
+ *
+ *      usage: <model>_mc [-j workers] [-n steps] [-m MID,...] [-i log]
+ *                        [-b base dir] [-o out dir] <case dir>...
+ *        -j   worker processes, default the number of online cores
+ *        -n   steps per case; default the steps of the -i log
+ *        -m   MIDs of ECI_MsgSnd to write, default all
+ *        -i   message log whose received messages are fed every case
+ *        -o   result directory, default "mc_out"
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "eci_rec.h"
+#include "eci_host.h"
+#include "eci_interface.h"
+#include "eci_host_rcv.h"
+
+#ifndef ECI_MC_MAX_OUT
+#define ECI_MC_MAX_OUT    64     /* ECI_MsgSnd entries written */
+#endif
+#define ECI_MC_TBL_HDR    116    /* cFE file header + table header bytes */
+#define ECI_MC_PATH_LEN   512
+
+/* Provided by the ECI app in flight builds */
+ECI_TimeStamp_t ECI_Step_TimeStamp = {0, 0};
+real_T          ECI_Step_Time      = 0.0;
+
+typedef struct {
+    const ECI_Msg_t *msg;
+    FILE            *data;
+    FILE            *time;
+} ECI_MC_Out_t;
+
+static const char    *baseDir = NULL;
+static const char    *outDir  = "mc_out";
+static unsigned long  steps   = 0;
+static ECI_Log_t      inLog;
+static int            haveLog = 0;
+static ECI_MC_Out_t   out[ECI_MC_MAX_OUT];
+static int            numOut  = 0;
+
+static const char *BaseName(const char *path)
+{
+    const char *s = strrchr(path, '/');
+    return (s != NULL && s[1] != '\0') ? s + 1 : path;
+}
+
+/* Function: SelectOutputs ================================================
+ * Abstract:
+ *   Picks the ECI_MsgSnd entries listed in midList (comma separated), or
+ *   all of them.
+ */
+static int SelectOutputs(const char *midList)
+{
+    const ECI_Msg_t *msg;
+    const char      *s;
+    char            *end;
+    unsigned long    mid;
+    int              found;
+
+    for (msg = ECI_MsgSnd; msg->mptr != NULL; msg++) {
+        found = (midList == NULL);
+        for (s = midList; s != NULL && *s != '\0' && !found; s = end) {
+            mid = strtoul(s, &end, 0);
+            if (end == s) {
+                fprintf(stderr, "%s: bad MID list %s\n", ECI_APP_NAME_LOWER, midList);
+                return -1;
+            }
+            found = ((uint32_t)msg->mid == (uint32_t)mid);
+            if (*end == ',') {
+                end++;
+            }
+        }
+        if (found) {
+            if (numOut == ECI_MC_MAX_OUT) {
+                fprintf(stderr, "%s: more than %d outputs\n", ECI_APP_NAME_LOWER, ECI_MC_MAX_OUT);
+                return -1;
+            }
+            out[numOut++].msg = msg;
+        }
+    }
+    return 0;
+}
+
+#ifdef ECI_PARAM_TBL_DEFINED
+/* Function: LoadTable ====================================================
+ * Abstract:
+ *   Reads a table image from the case directory, or the base directory,
+ *   and points the table at it.
+ */
+static int LoadTable(const char *caseDir, const ECI_Tbl_t *tbl)
+{
+    char        path[ECI_MC_PATH_LEN];
+    struct stat st;
+    FILE       *f;
+    void       *buf;
+    long        skip;
+
+    snprintf(path, sizeof(path), "%s/%s", caseDir, tbl->tblfilename);
+    if (stat(path, &st) != 0 && baseDir != NULL) {
+        snprintf(path, sizeof(path), "%s/%s", baseDir, tbl->tblfilename);
+    }
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "%s: no image %s for table %s\n", ECI_APP_NAME_LOWER, tbl->tblfilename, tbl->tblname);
+        return -1;
+    }
+    if ((size_t)st.st_size == tbl->tblsize) {
+        skip = 0;
+    } else if ((size_t)st.st_size == tbl->tblsize + ECI_MC_TBL_HDR) {
+        skip = ECI_MC_TBL_HDR;
+    } else {
+        fprintf(stderr, "%s: %s is %ld bytes, table %s is %lu\n", ECI_APP_NAME_LOWER, path,
+                (long)st.st_size, tbl->tblname, (unsigned long)tbl->tblsize);
+        return -1;
+    }
+
+    buf = malloc(tbl->tblsize);
+    f   = fopen(path, "rb");
+    if (buf == NULL || f == NULL || fseek(f, skip, SEEK_SET) != 0 ||
+        fread(buf, tbl->tblsize, 1, f) != 1) {
+        fprintf(stderr, "%s: could not read %s\n", ECI_APP_NAME_LOWER, path);
+        return -1;
+    }
+    fclose(f);
+    *tbl->tblptr = buf;
+    return 0;
+}
+#endif
+
+/* Function: OpenOutputs ==================================================
+ * Abstract:
+ *   Creates the result files of a case.
+ */
+static int OpenOutputs(const char *caseDir)
+{
+    char path[ECI_MC_PATH_LEN];
+    int  i;
+
+    snprintf(path, sizeof(path), "%s/%s", outDir, BaseName(caseDir));
+    if (mkdir(path, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "%s: could not create %s\n", ECI_APP_NAME_LOWER, path);
+        return -1;
+    }
+    for (i = 0; i < numOut; i++) {
+        snprintf(path, sizeof(path), "%s/%s/0x%04lX.bin", outDir, BaseName(caseDir),
+                 (unsigned long)out[i].msg->mid);
+        out[i].data = fopen(path, "wb");
+        snprintf(path, sizeof(path), "%s/%s/0x%04lX.time", outDir, BaseName(caseDir),
+                 (unsigned long)out[i].msg->mid);
+        out[i].time = fopen(path, "wb");
+        if (out[i].data == NULL || out[i].time == NULL) {
+            fprintf(stderr, "%s: could not create %s\n", ECI_APP_NAME_LOWER, path);
+            return -1;
+        }
+        setvbuf(out[i].data, NULL, _IOFBF, 1 << 20);
+    }
+    return 0;
+}
+
+/* Function: RunCase ======================================================
+ * Abstract:
+ *   Runs one case, in the forked worker.  Returns the exit status.
+ */
+static int RunCase(const char *caseDir)
+{
+    const ECI_Rec_Hdr_t *hdr = NULL;
+    const uint8_t       *payload;
+    unsigned long        step;
+    double               t;
+    int                  i;
+#ifdef ECI_PARAM_TBL_DEFINED
+    const ECI_Tbl_t     *tbl;
+
+    for (tbl = ECI_ParamTable; tbl->tblptr != NULL; tbl++) {
+        if (LoadTable(caseDir, tbl) != 0) {
+            return 1;
+        }
+    }
+#endif
+    if (OpenOutputs(caseDir) != 0) {
+        return 1;
+    }
+
+    ECI_INIT_FCN;
+
+    if (haveLog) {
+        hdr = ECI_Log_Next(&inLog, &payload);
+    }
+    for (step = 0; steps == 0 || step < steps; step++) {
+        if (haveLog) {
+            /* Step time and messages of the next logged step */
+            while (hdr != NULL && hdr->kind != ECI_REC_STEP) {
+                hdr = ECI_Log_Next(&inLog, &payload);
+            }
+            if (hdr == NULL) {
+                break;
+            }
+            memcpy(&ECI_Step_TimeStamp, payload, sizeof(ECI_TimeStamp_t));
+            while ((hdr = ECI_Log_Next(&inLog, &payload)) != NULL && hdr->kind != ECI_REC_STEP) {
+                if (hdr->kind == ECI_REC_RCV) {
+                    ECI_Host_Deliver(hdr->mid, payload, hdr->size);
+                }
+            }
+        } else {
+            t = (double)step * ECI_BASE_PERIOD;
+            ECI_Step_TimeStamp.Seconds    = (uint32_T)t;
+            ECI_Step_TimeStamp.Subseconds = (uint32_T)((t - (double)(uint32_T)t) * 4294967296.0);
+        }
+
+        ECI_Host_StepBegin();
+        ECI_STEP_FCN
+        ECI_Host_StepDone();
+
+        t = (double)ECI_Step_TimeStamp.Seconds + (double)ECI_Step_TimeStamp.Subseconds / 4294967296.0;
+        for (i = 0; i < numOut; i++) {
+            if (out[i].msg->sendMsg == NULL || *out[i].msg->sendMsg) {
+                fwrite(out[i].msg->mptr, out[i].msg->siz, 1, out[i].data);
+                fwrite(&t, sizeof(t), 1, out[i].time);
+            }
+        }
+    }
+
+    ECI_TERM_FCN
+
+    for (i = 0; i < numOut; i++) {
+        if (fclose(out[i].data) != 0 || fclose(out[i].time) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *midList = NULL;
+    long        workers = sysconf(_SC_NPROCESSORS_ONLN);
+    int         numCases;
+    pid_t      *pids;
+    double     *starts;
+    int        *status;
+    int         next    = 0;
+    int         running = 0;
+    int         failed  = 0;
+    int         i;
+    int         opt;
+    pid_t       pid;
+    int         wstatus;
+    double      t0;
+    char        path[ECI_MC_PATH_LEN];
+    FILE       *csv;
+
+    while ((opt = getopt(argc, argv, "j:n:m:i:b:o:")) != -1) {
+        switch (opt) {
+          case 'j': workers = strtol(optarg, NULL, 0); break;
+          case 'n': steps   = strtoul(optarg, NULL, 0); break;
+          case 'm': midList = optarg; break;
+          case 'i':
+            if (ECI_Log_Map(&inLog, optarg) != 0) {
+                fprintf(stderr, "%s: could not map log %s\n", ECI_APP_NAME_LOWER, optarg);
+                return 1;
+            }
+            haveLog = 1;
+            break;
+          case 'b': baseDir = optarg; break;
+          case 'o': outDir  = optarg; break;
+          default:
+            optind = argc;
+            break;
+        }
+    }
+    if (optind >= argc || (steps == 0 && !haveLog)) {
+        fprintf(stderr, "usage: %s [-j workers] [-n steps] [-m MID,...] [-i log] [-b base dir] "
+                "[-o out dir] <case dir>...\n", argv[0]);
+        return 1;
+    }
+    if (workers < 1) {
+        workers = 1;
+    }
+    if (SelectOutputs(midList) != 0) {
+        return 1;
+    }
+    if (mkdir(outDir, 0777) != 0 && errno != EEXIST) {
+        fprintf(stderr, "%s: could not create %s\n", ECI_APP_NAME_LOWER, outDir);
+        return 1;
+    }
+
+    numCases = argc - optind;
+    pids     = calloc((size_t)numCases, sizeof(*pids));
+    starts   = calloc((size_t)numCases, sizeof(*starts));
+    status   = calloc((size_t)numCases, sizeof(*status));
+    if (pids == NULL || starts == NULL || status == NULL) {
+        return 1;
+    }
+
+    /* Fork a worker per case, keeping up to workers running */
+    t0 = Now();
+    fflush(NULL);
+    while (next < numCases || running > 0) {
+        if (next < numCases && running < workers) {
+            pid = fork();
+            if (pid == 0) {
+                _exit(RunCase(argv[optind + next]));
+            }
+            if (pid < 0) {
+                /* failed case, it never ran */
+                fprintf(stderr, "%s: fork failed\n", ECI_APP_NAME_LOWER);
+                status[next] = -1;
+                starts[next] = 0.0;
+            } else {
+                pids[next]   = pid;
+                starts[next] = Now();
+                running++;
+            }
+            next++;
+            continue;
+        }
+        pid = wait(&wstatus);
+        if (pid < 0) {
+            break;
+        }
+        for (i = 0; i < next; i++) {
+            if (pids[i] == pid) {
+                status[i] = WIFEXITED(wstatus) ? WEXITSTATUS(wstatus) : 128 + WTERMSIG(wstatus);
+                starts[i] = Now() - starts[i];
+                pids[i]   = 0;
+                running--;
+                break;
+            }
+        }
+    }
+
+    snprintf(path, sizeof(path), "%s/cases.csv", outDir);
+    csv = fopen(path, "w");
+    if (csv != NULL) {
+        fprintf(csv, "case,status,seconds\n");
+    }
+    for (i = 0; i < numCases; i++) {
+        if (status[i] != 0) {
+            failed++;
+        }
+        if (csv != NULL) {
+            fprintf(csv, "%s,%d,%.6f\n", BaseName(argv[optind + i]), status[i], starts[i]);
+        }
+    }
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    printf("%s: %d cases, %d failed, %ld workers, %.3f s\n", ECI_APP_NAME_LOWER, numCases, failed,
+           workers, Now() - t0);
+
+    if (haveLog) {
+        ECI_Log_Unmap(&inLog);
+    }
+    return (failed == 0) ? 0 : 2;
+}
@@ -0,0 +1,201 @@
+/**
+ * eci_rec.c
+ *
+ *    ABSTRACT:
+ *      Message recorder and log reader (see eci_rec.h).
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eci_rec.h"
+
+/* Function: ECI_Rec_Open =================================================
+ * Abstract:
+ *   Creates the log and writes its file header.
+ */
+int ECI_Rec_Open(ECI_Rec_t *rec, const char *path)
+{
+    ECI_Rec_FileHdr_t hdr = { ECI_REC_MAGIC, ECI_REC_VERSION, sizeof(ECI_Rec_Hdr_t), 0 };
+
+    rec->file    = fopen(path, "wb");
+    rec->step    = 0;
+    rec->started = 0;
+    if (rec->file == NULL) {
+        return -1;
+    }
+    if (fwrite(&hdr, sizeof(hdr), 1, rec->file) != 1) {
+        fclose(rec->file);
+        rec->file = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/* Function: ECI_Rec_Close ================================================
+ * Abstract:
+ *   Flushes and closes the log.
+ */
+int ECI_Rec_Close(ECI_Rec_t *rec)
+{
+    int status = 0;
+    if (rec->file != NULL) {
+        status = fclose(rec->file);
+        rec->file = NULL;
+    }
+    return status;
+}
+
+/* Function: ECI_Rec_Msg ==================================================
+ * Abstract:
+ *   Appends one record with its payload padded to 8 bytes.
+ */
+int ECI_Rec_Msg(ECI_Rec_t *rec, uint32_t kind, uint32_t mid, const void *msg, size_t size)
+{
+    static const uint8_t pad[8] = {0};
+    ECI_Rec_Hdr_t hdr;
+    size_t        padLen = ECI_REC_PAD(size) - size;
+
+    if (rec->file == NULL) {
+        return -1;
+    }
+    hdr.kind = kind;
+    hdr.mid  = mid;
+    hdr.size = (uint32_t)size;
+    hdr.step = rec->step;
+    if (fwrite(&hdr, sizeof(hdr), 1, rec->file) != 1 ||
+        (size > 0 && fwrite(msg, size, 1, rec->file) != 1) ||
+        (padLen > 0 && fwrite(pad, padLen, 1, rec->file) != 1)) {
+        return -1;
+    }
+    return 0;
+}
+
+/* Function: ECI_Rec_Step =================================================
+ * Abstract:
+ *   Starts the next step.
+ */
+int ECI_Rec_Step(ECI_Rec_t *rec, const ECI_TimeStamp_t *ts)
+{
+    if (rec->started) {
+        rec->step++;
+    }
+    rec->started = 1;
+    return ECI_Rec_Msg(rec, ECI_REC_STEP, 0, ts, sizeof(*ts));
+}
+
+/* Function: ECI_Rec_SndTable =============================================
+ * Abstract:
+ *   Records the messages sent this step.
+ */
+int ECI_Rec_SndTable(ECI_Rec_t *rec, const ECI_Msg_t *sndTbl)
+{
+    const ECI_Msg_t *msg;
+
+    for (msg = sndTbl; msg->mptr != NULL; msg++) {
+        if (msg->sendMsg == NULL || *msg->sendMsg) {
+            if (ECI_Rec_Msg(rec, ECI_REC_SND, (uint32_t)msg->mid, msg->mptr, msg->siz) != 0) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Function: ECI_Rec_Deliver ============================================
+ * Abstract:
+ *   Copies a message to its ECI_MsgRcv buffer, truncated to the buffer.
+ */
+const ECI_Msg_t *ECI_Rec_Deliver(const ECI_Msg_t *rcvTbl, uint32_t mid, const void *msg, size_t size)
+{
+    const ECI_Msg_t *ent;
+
+    for (ent = rcvTbl; ent->mptr != NULL; ent++) {
+        if ((uint32_t)ent->mid == mid) {
+            memcpy(ent->mptr, msg, (size < ent->siz) ? size : ent->siz);
+            return ent;
+        }
+    }
+    return NULL;
+}
+
+/* Function: ECI_Log_Map ==================================================
+ * Abstract:
+ *   Maps a log read only and checks its file header.
+ */
+int ECI_Log_Map(ECI_Log_t *log, const char *path)
+{
+    int                      fd;
+    struct stat              st;
+    void                    *mem;
+    const ECI_Rec_FileHdr_t *hdr;
+
+    log->base = NULL;
+    log->size = 0;
+    log->pos  = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ECI_Rec_FileHdr_t)) {
+        close(fd);
+        return -1;
+    }
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return -1;
+    }
+
+    hdr = (const ECI_Rec_FileHdr_t *)mem;
+    if (hdr->magic != ECI_REC_MAGIC || hdr->version != ECI_REC_VERSION ||
+        hdr->recHdrSize != sizeof(ECI_Rec_Hdr_t)) {
+        munmap(mem, (size_t)st.st_size);
+        return -1;
+    }
+    posix_madvise(mem, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+
+    log->base = (const uint8_t *)mem;
+    log->size = (size_t)st.st_size;
+    log->pos  = sizeof(ECI_Rec_FileHdr_t);
+    return 0;
+}
+
+/* Function: ECI_Log_Unmap ================================================
+ * Abstract:
+ *   Releases the mapping.
+ */
+void ECI_Log_Unmap(ECI_Log_t *log)
+{
+    if (log->base != NULL) {
+        munmap((void *)log->base, log->size);
+        log->base = NULL;
+    }
+}
+
+/* Function: ECI_Log_Next =================================================
+ * Abstract:
+ *   Returns the next record and advances past it.
+ */
+const ECI_Rec_Hdr_t *ECI_Log_Next(ECI_Log_t *log, const uint8_t **payload)
+{
+    const ECI_Rec_Hdr_t *hdr;
+
+    if (log->base == NULL || log->pos + sizeof(ECI_Rec_Hdr_t) > log->size) {
+        return NULL;
+    }
+    hdr = (const ECI_Rec_Hdr_t *)(log->base + log->pos);
+    if (log->pos + sizeof(ECI_Rec_Hdr_t) + ECI_REC_PAD(hdr->size) > log->size) {
+        return NULL;
+    }
+    *payload  = log->base + log->pos + sizeof(ECI_Rec_Hdr_t);
+    log->pos += sizeof(ECI_Rec_Hdr_t) + ECI_REC_PAD(hdr->size);
+    return hdr;
+}
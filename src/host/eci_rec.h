@@ -0,0 +1,90 @@
+/**
+ * eci_rec.h
+ *
+ *    ABSTRACT:
+ *      Recorder for the messages a SIL generated model receives and sends,
+ *      for replay on a host build (see eci_replay.c).
+ *
+ *      The log is a flat file that can be memory mapped: a file header,
+ *      then per step one ECI_REC_STEP record holding ECI_Step_TimeStamp,
+ *      an ECI_REC_RCV record for each message received before the step,
+ *      in arrival order, and the ECI_REC_SND records of the messages sent
+ *      from ECI_MsgSnd after it.  Only messages that arrived are logged,
+ *      not the whole ECI_MsgRcv table.  Each record is a 16 byte header
+ *      and its payload, padded to 8 bytes.  Fields are in host byte order.
+ *
+ */
+
+#ifndef ECI_REC_H
+#define ECI_REC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "eci_app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECI_REC_MAGIC    0x52494345U   /* "ECIR" */
+#define ECI_REC_VERSION  1
+
+/* Record kinds */
+#define ECI_REC_STEP     1   /* payload: ECI_TimeStamp_t of the step */
+#define ECI_REC_RCV      2   /* payload: message copied to ECI_MsgRcv */
+#define ECI_REC_SND      3   /* payload: message sent from ECI_MsgSnd */
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recHdrSize;       /* sizeof(ECI_Rec_Hdr_t) */
+    uint32_t spare;
+} ECI_Rec_FileHdr_t;
+
+typedef struct {
+    uint32_t kind;
+    uint32_t mid;
+    uint32_t size;             /* payload bytes, before padding */
+    uint32_t step;             /* step number, from 0 */
+} ECI_Rec_Hdr_t;
+
+#define ECI_REC_PAD(n)   (((n) + 7U) & ~(size_t)7U)
+
+typedef struct {
+    FILE     *file;
+    uint32_t  step;
+    int       started;
+} ECI_Rec_t;
+
+int  ECI_Rec_Open(ECI_Rec_t *rec, const char *path);
+int  ECI_Rec_Close(ECI_Rec_t *rec);
+/* Starts a new step, recording its timestamp */
+int  ECI_Rec_Step(ECI_Rec_t *rec, const ECI_TimeStamp_t *ts);
+int  ECI_Rec_Msg(ECI_Rec_t *rec, uint32_t kind, uint32_t mid, const void *msg, size_t size);
+/* Records the unconditional and flagged entries of an ECI_MsgSnd table */
+int  ECI_Rec_SndTable(ECI_Rec_t *rec, const ECI_Msg_t *sndTbl);
+/* Copies a received message to the mptr of its ECI_MsgRcv entry, as the
+ * ECI app does.  Returns the entry, or NULL when the MID is not in the
+ * table. */
+const ECI_Msg_t *ECI_Rec_Deliver(const ECI_Msg_t *rcvTbl, uint32_t mid, const void *msg, size_t size);
+
+/* Read only mapping of a log */
+typedef struct {
+    const uint8_t *base;
+    size_t         size;
+    size_t         pos;
+} ECI_Log_t;
+
+int  ECI_Log_Map(ECI_Log_t *log, const char *path);
+void ECI_Log_Unmap(ECI_Log_t *log);
+/* Next record (NULL at the end of the log or on a truncated record);
+ * *payload points into the mapping. */
+const ECI_Rec_Hdr_t *ECI_Log_Next(ECI_Log_t *log, const uint8_t **payload);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECI_REC_H */
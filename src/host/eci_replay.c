@@ -0,0 +1,245 @@
+/**
+ * eci_replay.c
+ *
+ *    ABSTRACT:
+ *      Replays a message log (eci_rec.h) into a host build of one SIL
+ *      generated model as fast as it will step.  Each logged step sets
+ *      ECI_Step_TimeStamp, copies the logged messages into ECI_MsgRcv in
+ *      arrival order and runs ECI_STEP_FCN; the messages ECI_MsgSnd sends
+ *      are then compared with the ECI_REC_SND records of the same step in
+ *      the reference log (by default the replayed log itself).
+ *
+ *      Build against the generated code of one model, e.g.
+ *        gcc -O2 -I<model build dir> -I<eci_app.h dir> eci_replay.c \
+ *            eci_rec.c <model sources> -o <model>_replay -lm
+ *
+ *      usage: <model>_replay [-r ref log] [-s bytes] [-o out log] [-n max] <log>
+ *        -r   reference log of sent messages (default: <log>)
+ *        -s   bytes at the start of each message not compared, e.g. the
+ *             telemetry header whose time the ECI app stamps
+ *        -o   record the replay (received and sent messages) to a new log
+ *        -n   mismatches printed, default 20
+ *
+ *      Exit status is 0 when every step matched, 2 on a mismatch.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "eci_rec.h"
+#include "eci_host.h"
+#include "eci_interface.h"
+#include "eci_host_rcv.h"
+
+/* Provided by the ECI app in flight builds */
+ECI_TimeStamp_t ECI_Step_TimeStamp = {0, 0};
+real_T          ECI_Step_Time      = 0.0;
+
+static unsigned long mismatches = 0;
+static unsigned long maxPrint   = 20;
+
+static void Mismatch(uint32_t step, uint32_t mid, const char *fmt, ...)
+{
+    va_list args;
+
+    mismatches++;
+    if (mismatches <= maxPrint) {
+        printf("step %lu: MID 0x%04lX ", (unsigned long)step, (unsigned long)mid);
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+        printf("\n");
+    }
+}
+
+/* Function: NextSnd ======================================================
+ * Abstract:
+ *   Next ECI_REC_SND record of a step in the reference log, skipping the
+ *   records of earlier steps.  Stops, without consuming it, at the first
+ *   record of a later step.
+ */
+static const ECI_Rec_Hdr_t *NextSnd(ECI_Log_t *ref, uint32_t step, const uint8_t **payload)
+{
+    const ECI_Rec_Hdr_t *hdr;
+    size_t               pos;
+
+    for (;;) {
+        pos = ref->pos;
+        hdr = ECI_Log_Next(ref, payload);
+        if (hdr == NULL) {
+            return NULL;
+        }
+        if (hdr->step > step) {
+            ref->pos = pos;
+            return NULL;
+        }
+        if (hdr->step == step && hdr->kind == ECI_REC_SND) {
+            return hdr;
+        }
+    }
+}
+
+/* Function: CompareStep ==================================================
+ * Abstract:
+ *   Compares the messages sent this step with the reference, in
+ *   ECI_MsgSnd order.
+ */
+static void CompareStep(ECI_Log_t *ref, uint32_t step, size_t skip)
+{
+    const ECI_Msg_t     *msg;
+    const ECI_Rec_Hdr_t *hdr;
+    const uint8_t       *payload;
+    const uint8_t       *out;
+    size_t               i;
+
+    for (msg = ECI_MsgSnd; msg->mptr != NULL; msg++) {
+        if (msg->sendMsg != NULL && !*msg->sendMsg) {
+            continue;
+        }
+        hdr = NextSnd(ref, step, &payload);
+        if (hdr == NULL) {
+            Mismatch(step, (uint32_t)msg->mid, "sent, not in reference");
+            continue;
+        }
+        if (hdr->mid != (uint32_t)msg->mid) {
+            Mismatch(step, (uint32_t)msg->mid, "sent, reference has MID 0x%04lX", (unsigned long)hdr->mid);
+            continue;
+        }
+        if (hdr->size != msg->siz) {
+            Mismatch(step, hdr->mid, "is %lu bytes, reference %lu", (unsigned long)msg->siz, (unsigned long)hdr->size);
+            continue;
+        }
+        out = (const uint8_t *)msg->mptr;
+        for (i = skip; i < msg->siz; i++) {
+            if (out[i] != payload[i]) {
+                Mismatch(step, hdr->mid, "differs from reference at byte %lu", (unsigned long)i);
+                break;
+            }
+        }
+    }
+    while ((hdr = NextSnd(ref, step, &payload)) != NULL) {
+        Mismatch(step, hdr->mid, "in reference, not sent");
+    }
+}
+
+static double TimeStampSec(const ECI_TimeStamp_t *ts)
+{
+    return (double)ts->Seconds + (double)ts->Subseconds / 4294967296.0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char          *refPath = NULL;
+    const char          *outPath = NULL;
+    size_t               skip    = 0;
+    ECI_Log_t            log;
+    ECI_Log_t            ref;
+    ECI_Rec_t            rec;
+    const ECI_Rec_Hdr_t *hdr;
+    const uint8_t       *payload;
+    ECI_TimeStamp_t      first   = {0, 0};
+    unsigned long        steps   = 0;
+    unsigned long        msgs    = 0;
+    unsigned long        unknown = 0;
+    uint32_t             step;
+    struct timespec      start;
+    struct timespec      end;
+    double               cpuSec;
+    double               logSec;
+    int                  opt;
+
+    while ((opt = getopt(argc, argv, "r:s:o:n:")) != -1) {
+        switch (opt) {
+          case 'r': refPath  = optarg; break;
+          case 's': skip     = strtoul(optarg, NULL, 0); break;
+          case 'o': outPath  = optarg; break;
+          case 'n': maxPrint = strtoul(optarg, NULL, 0); break;
+          default:
+            fprintf(stderr, "usage: %s [-r ref log] [-s bytes] [-o out log] [-n max] <log>\n", argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc) {
+        fprintf(stderr, "usage: %s [-r ref log] [-s bytes] [-o out log] [-n max] <log>\n", argv[0]);
+        return 1;
+    }
+    if (refPath == NULL) {
+        refPath = argv[optind];
+    }
+    if (ECI_Log_Map(&log, argv[optind]) != 0 || ECI_Log_Map(&ref, refPath) != 0) {
+        fprintf(stderr, "%s: could not map log %s or %s\n", ECI_APP_NAME_LOWER, argv[optind], refPath);
+        return 1;
+    }
+    if (outPath != NULL && ECI_Rec_Open(&rec, outPath) != 0) {
+        fprintf(stderr, "%s: could not create log %s\n", ECI_APP_NAME_LOWER, outPath);
+        return 1;
+    }
+
+    ECI_INIT_FCN;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    hdr = ECI_Log_Next(&log, &payload);
+    while (hdr != NULL) {
+        if (hdr->kind != ECI_REC_STEP || hdr->size != sizeof(ECI_TimeStamp_t)) {
+            hdr = ECI_Log_Next(&log, &payload);
+            continue;
+        }
+        step = hdr->step;
+        memcpy(&ECI_Step_TimeStamp, payload, sizeof(ECI_TimeStamp_t));
+        if (steps == 0) {
+            first = ECI_Step_TimeStamp;
+        }
+        if (outPath != NULL) {
+            ECI_Rec_Step(&rec, &ECI_Step_TimeStamp);
+        }
+
+        /* Messages received before the step */
+        while ((hdr = ECI_Log_Next(&log, &payload)) != NULL && hdr->kind != ECI_REC_STEP) {
+            if (hdr->kind == ECI_REC_RCV) {
+                msgs++;
+                if (!ECI_Host_Deliver(hdr->mid, payload, hdr->size)) {
+                    unknown++;
+                }
+                if (outPath != NULL) {
+                    ECI_Rec_Msg(&rec, ECI_REC_RCV, hdr->mid, payload, hdr->size);
+                }
+            }
+        }
+
+        ECI_Host_StepBegin();
+        ECI_STEP_FCN
+        ECI_Host_StepDone();
+
+        if (outPath != NULL) {
+            ECI_Rec_SndTable(&rec, ECI_MsgSnd);
+        }
+        CompareStep(&ref, step, skip);
+        steps++;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    ECI_TERM_FCN
+
+    cpuSec = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) * 1e-9;
+    logSec = TimeStampSec(&ECI_Step_TimeStamp) - TimeStampSec(&first);
+    printf("%s: replayed %lu steps, %lu messages (%lu not in ECI_MsgRcv) in %.3f s",
+           ECI_APP_NAME_LOWER, steps, msgs, unknown, cpuSec);
+    if (cpuSec > 0.0 && logSec > 0.0) {
+        printf(", %.1f x real time", logSec / cpuSec);
+    }
+    printf("\n%s: %lu mismatches\n", ECI_APP_NAME_LOWER, mismatches);
+
+    if (outPath != NULL) {
+        ECI_Rec_Close(&rec);
+    }
+    ECI_Log_Unmap(&ref);
+    ECI_Log_Unmap(&log);
+    return (mismatches == 0) ? 0 : 2;
+}
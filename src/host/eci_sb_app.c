@@ -0,0 +1,156 @@
+/**
+ * eci_sb_app.c
+ *
+ *    ABSTRACT:
+ *      Host process wrapper running one SIL generated model on the shared
+ *      memory software bus stand-in (eci_sb_shm.c).  It stands in for the
+ *      ECI app: each step drains the model's pipe into ECI_MsgRcv, runs
+ *      ECI_STEP_FCN and sends ECI_MsgSnd.  Start one process per model
+ *      on the same bus name to have the models exchange messages.
+ *
+ *      Build against the generated code of one model, e.g.
+ *        gcc -O2 -I<model build dir> -I<eci_app.h dir> eci_sb_app.c \
+ *            eci_sb_shm.c eci_rec.c <model sources> -o <model>_sb -lrt -lm
+ *
+ *      usage: <model>_sb <bus> [steps] [period us] [stats period s] [log]
+ *        steps         0 (default) runs until killed
+ *        period us     step period, 0 (default) runs free
+ *        log           records the messages received and sent each step
+ *                      for eci_replay.c
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "eci_rec.h"
+#include "eci_sb_shm.h"
+#include "eci_host.h"
+#include "eci_interface.h"
+#include "eci_host_rcv.h"
+
+/* Provided by the ECI app in flight builds */
+ECI_TimeStamp_t ECI_Step_TimeStamp = {0, 0};
+real_T          ECI_Step_Time      = 0.0;
+
+/* Function: SetStepTime ==================================================
+ * Abstract:
+ *   ECI_Step_TimeStamp from the host clock (subseconds LSB = 2^-32 s).
+ */
+static void SetStepTime(const struct timespec *now)
+{
+    ECI_Step_TimeStamp.Seconds    = (uint32_T)now->tv_sec;
+    ECI_Step_TimeStamp.Subseconds = (uint32_T)(((uint64_t)now->tv_nsec << 32) / 1000000000ULL);
+}
+
+/* Function: ReceiveRecord ================================================
+ * Abstract:
+ *   ECI_SB_ReceiveTable, also recording each message received, and
+ *   filling batched and buffered inputs (eci_host_rcv.h).
+ */
+static int ReceiveRecord(ECI_Rec_t *rec, int pipe)
+{
+    static uint8_t buf[ECI_SB_MAX_MSG_SIZE];
+    uint32_t       mid;
+    size_t         size;
+    int            count = 0;
+
+    while (ECI_SB_Receive(pipe, &mid, buf, sizeof(buf), &size) != ECI_SB_NO_MESSAGE) {
+        count++;
+        if (rec->file != NULL) {
+            ECI_Rec_Msg(rec, ECI_REC_RCV, mid, buf, size);
+        }
+        ECI_Host_Deliver(mid, buf, size);
+    }
+    return count;
+}
+
+static double Elapsed(const struct timespec *from, const struct timespec *to)
+{
+    return (double)(to->tv_sec - from->tv_sec) +
+           (double)(to->tv_nsec - from->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+    static ECI_SB_Stats_t prev[ECI_SB_MAX_PIPES];
+    unsigned long   steps    = 0;
+    unsigned long   periodUs = 0;
+    double          statsSec = 1.0;
+    ECI_Rec_t       rec      = {NULL, 0, 0};
+    unsigned long   step;
+    unsigned long   sent     = 0;
+    int             pipe;
+    struct timespec next;
+    struct timespec now;
+    struct timespec lastStats;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <bus> [steps] [period us] [stats period s] [log]\n", argv[0]);
+        return 1;
+    }
+    if (argc > 2) steps    = strtoul(argv[2], NULL, 0);
+    if (argc > 3) periodUs = strtoul(argv[3], NULL, 0);
+    if (argc > 4) statsSec = atof(argv[4]);
+    if (argc > 5 && ECI_Rec_Open(&rec, argv[5]) != 0) {
+        fprintf(stderr, "%s: could not create log %s\n", ECI_APP_NAME_LOWER, argv[5]);
+        return 1;
+    }
+
+    if (ECI_SB_Attach(argv[1], 1) != ECI_SB_SUCCESS) {
+        fprintf(stderr, "%s: could not attach to bus %s\n", ECI_APP_NAME_LOWER, argv[1]);
+        return 1;
+    }
+    pipe = ECI_SB_CreatePipe(ECI_DATA_PIPE_NAME);
+    if (pipe < 0 || ECI_SB_SubscribeTable(pipe, ECI_MsgRcv) != ECI_SB_SUCCESS) {
+        fprintf(stderr, "%s: could not create pipe %s\n", ECI_APP_NAME_LOWER, ECI_DATA_PIPE_NAME);
+        return 1;
+    }
+
+    ECI_INIT_FCN;
+
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    lastStats = next;
+    for (step = 0; steps == 0 || step < steps; step++) {
+        clock_gettime(CLOCK_REALTIME, &now);
+        SetStepTime(&now);
+
+        if (rec.file != NULL) {
+            ECI_Rec_Step(&rec, &ECI_Step_TimeStamp);
+        }
+        ReceiveRecord(&rec, pipe);
+        ECI_Host_StepBegin();
+        ECI_STEP_FCN
+        ECI_Host_StepDone();
+        sent += ECI_SB_SendTable(ECI_MsgSnd);
+        if (rec.file != NULL) {
+            ECI_Rec_SndTable(&rec, ECI_MsgSnd);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (statsSec > 0.0 && Elapsed(&lastStats, &now) >= statsSec) {
+            printf("%s: step %lu, sent %lu\n", ECI_APP_NAME_LOWER, step + 1, sent);
+            ECI_SB_PrintStats(stdout, prev, Elapsed(&lastStats, &now));
+            fflush(stdout);
+            lastStats = now;
+        }
+
+        if (periodUs > 0) {
+            next.tv_nsec += (long)(periodUs % 1000000UL) * 1000L;
+            next.tv_sec  += (time_t)(periodUs / 1000000UL);
+            if (next.tv_nsec >= 1000000000L) {
+                next.tv_nsec -= 1000000000L;
+                next.tv_sec++;
+            }
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        }
+    }
+
+    ECI_TERM_FCN
+    ECI_Rec_Close(&rec);
+    ECI_SB_Detach();
+    return 0;
+}
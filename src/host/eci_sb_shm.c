@@ -0,0 +1,505 @@
+/**
+ * eci_sb_shm.c
+ *
+ *    ABSTRACT:
+ *      Shared memory software bus stand-in (see eci_sb_shm.h).
+ *
+ *      The bus is one POSIX shared memory segment holding a subscription
+ *      table and ECI_SB_MAX_PIPES pipes.  Each pipe is a bounded
+ *      multi-producer ring: a slot's sequence number tells producers when
+ *      it is free and the consumer when it is filled, so senders from any
+ *      process claim slots with a compare-and-swap and never wait.
+ *
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "eci_sb_shm.h"
+
+#define ECI_SB_MAGIC     0x45434932U   /* "ECI2", bus layout version */
+#define ECI_SB_SLOT_MASK (ECI_SB_PIPE_DEPTH - 1)
+
+#if (ECI_SB_PIPE_DEPTH & ECI_SB_SLOT_MASK) != 0
+#error "ECI_SB_PIPE_DEPTH must be a power of 2"
+#endif
+
+typedef struct {
+    _Atomic uint64_t seq;      /* == pos: free, == pos+1: filled */
+    uint64_t         sendNs;
+    uint32_t         mid;
+    uint32_t         size;
+    uint8_t          data[ECI_SB_MAX_MSG_SIZE];
+} ECI_SB_Slot_t;
+
+typedef struct {
+    _Atomic uint32_t inUse;
+    char             name[ECI_SB_PIPE_NAME_LEN];
+    _Atomic uint64_t head;     /* next slot to fill */
+    _Atomic uint64_t tail;     /* next slot to read (one reader) */
+    _Atomic uint64_t received;
+    _Atomic uint64_t drops;
+    _Atomic uint64_t latSumNs;
+    _Atomic uint64_t latMaxNs;
+    ECI_SB_Slot_t    slots[ECI_SB_PIPE_DEPTH];
+} ECI_SB_Pipe_t;
+
+typedef struct {
+    _Atomic uint32_t valid;
+    uint32_t         mid;
+    uint32_t         pipe;
+} ECI_SB_Sub_t;
+
+typedef struct {
+    _Atomic uint32_t magic;
+    _Atomic uint32_t numPipes;      /* pipes initialized and visible */
+    _Atomic uint32_t reservedPipes; /* pipe slots handed out */
+    _Atomic uint32_t numSubs;
+    _Atomic uint64_t noSubscriber;
+    ECI_SB_Sub_t     subs[ECI_SB_MAX_SUBS];
+    ECI_SB_Pipe_t    pipes[ECI_SB_MAX_PIPES];
+} ECI_SB_Bus_t;
+
+static ECI_SB_Bus_t *sbBus = NULL;
+
+/* Function: ECI_SB_NowNs =================================================
+ * Abstract:
+ *   Monotonic time in ns, comparable between processes on the host.
+ */
+static uint64_t ECI_SB_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/* Function: ECI_SB_ShmName ===============================================
+ * Abstract:
+ *   Shared memory object name of a bus.
+ */
+static void ECI_SB_ShmName(const char *busName, char *name, size_t len)
+{
+    snprintf(name, len, "/eci_sb_%s", busName);
+}
+
+/* Function: ECI_SB_Attach ================================================
+ * Abstract:
+ *   Maps the bus segment, creating and initializing it if asked.  Other
+ *   processes wait until the creator has published the magic number.
+ */
+int ECI_SB_Attach(const char *busName, int create)
+{
+    char   name[64];
+    int    fd;
+    int    created = 0;
+    void  *mem;
+    int    tries;
+    struct timespec wait = {0, 1000000L};
+
+    if (sbBus != NULL) {
+        return ECI_SB_SUCCESS;
+    }
+    ECI_SB_ShmName(busName, name, sizeof(name));
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0 && create && errno == ENOENT) {
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0660);
+        if (fd >= 0) {
+            created = 1;
+            if (ftruncate(fd, sizeof(ECI_SB_Bus_t)) != 0) {
+                close(fd);
+                shm_unlink(name);
+                return ECI_SB_ERROR;
+            }
+        } else if (errno == EEXIST) {
+            /* lost the race to another creator */
+            fd = shm_open(name, O_RDWR, 0);
+        }
+    }
+    if (fd < 0) {
+        return ECI_SB_ERROR;
+    }
+
+    mem = mmap(NULL, sizeof(ECI_SB_Bus_t), PROT_READ | PROT_WRITE,
+               MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return ECI_SB_ERROR;
+    }
+    sbBus = (ECI_SB_Bus_t *)mem;
+
+    if (created) {
+        /* ftruncate zero fills the segment */
+        atomic_store_explicit(&sbBus->magic, ECI_SB_MAGIC, memory_order_release);
+    } else {
+        for (tries = 0; tries < 1000; tries++) {
+            if (atomic_load_explicit(&sbBus->magic, memory_order_acquire) == ECI_SB_MAGIC) {
+                return ECI_SB_SUCCESS;
+            }
+            nanosleep(&wait, NULL);
+        }
+        ECI_SB_Detach();
+        return ECI_SB_ERROR;
+    }
+    return ECI_SB_SUCCESS;
+}
+
+/* Function: ECI_SB_Detach ================================================
+ * Abstract:
+ *   Unmaps the bus segment of this process.
+ */
+void ECI_SB_Detach(void)
+{
+    if (sbBus != NULL) {
+        munmap(sbBus, sizeof(ECI_SB_Bus_t));
+        sbBus = NULL;
+    }
+}
+
+/* Function: ECI_SB_Unlink ================================================
+ * Abstract:
+ *   Removes the bus segment (processes attached keep their mapping).
+ */
+int ECI_SB_Unlink(const char *busName)
+{
+    char name[64];
+    ECI_SB_ShmName(busName, name, sizeof(name));
+    return (shm_unlink(name) == 0) ? ECI_SB_SUCCESS : ECI_SB_ERROR;
+}
+
+/* Function: ECI_SB_CreatePipe ============================================
+ * Abstract:
+ *   Returns the pipe of that name, claiming and initializing a new one if
+ *   none exists.  Pipes are not deleted; the pipe name must be unique per
+ *   process on the bus.
+ */
+int ECI_SB_CreatePipe(const char *name)
+{
+    uint32_t i;
+    uint32_t n;
+    ECI_SB_Pipe_t *pipe;
+
+    if (sbBus == NULL) {
+        return ECI_SB_ERROR;
+    }
+
+    n = atomic_load_explicit(&sbBus->numPipes, memory_order_acquire);
+    for (i = 0; i < n && i < ECI_SB_MAX_PIPES; i++) {
+        pipe = &sbBus->pipes[i];
+        if (atomic_load_explicit(&pipe->inUse, memory_order_acquire) &&
+            strncmp(pipe->name, name, ECI_SB_PIPE_NAME_LEN) == 0) {
+            return (int)i;
+        }
+    }
+
+    i = atomic_fetch_add(&sbBus->reservedPipes, 1);
+    if (i >= ECI_SB_MAX_PIPES) {
+        return ECI_SB_ERROR;
+    }
+    pipe = &sbBus->pipes[i];
+    strncpy(pipe->name, name, ECI_SB_PIPE_NAME_LEN - 1);
+    atomic_store(&pipe->head, 0);
+    atomic_store(&pipe->tail, 0);
+    for (n = 0; n < ECI_SB_PIPE_DEPTH; n++) {
+        atomic_store_explicit(&pipe->slots[n].seq, n, memory_order_relaxed);
+    }
+    atomic_store_explicit(&pipe->inUse, 1, memory_order_release);
+
+    /* Only now count the pipe, so that no process finds a pipe whose 
+     * slots are not set up.  Creators may finish out of order. */
+    n = atomic_load_explicit(&sbBus->numPipes, memory_order_relaxed);
+    while (n < i + 1 &&
+           !atomic_compare_exchange_weak_explicit(&sbBus->numPipes, &n, i + 1,
+                                                  memory_order_release,
+                                                  memory_order_relaxed)) {
+    }
+    return (int)i;
+}
+
+/* Function: ECI_SB_Subscribe =============================================
+ * Abstract:
+ *   Routes messages with this MID to the pipe.
+ */
+int ECI_SB_Subscribe(uint32_t mid, int pipe)
+{
+    uint32_t i;
+    uint32_t n;
+
+    if (sbBus == NULL || pipe < 0 || pipe >= ECI_SB_MAX_PIPES) {
+        return ECI_SB_ERROR;
+    }
+
+    n = atomic_load_explicit(&sbBus->numSubs, memory_order_acquire);
+    for (i = 0; i < n && i < ECI_SB_MAX_SUBS; i++) {
+        if (atomic_load_explicit(&sbBus->subs[i].valid, memory_order_acquire) &&
+            sbBus->subs[i].mid == mid && sbBus->subs[i].pipe == (uint32_t)pipe) {
+            return ECI_SB_SUCCESS;
+        }
+    }
+
+    i = atomic_fetch_add(&sbBus->numSubs, 1);
+    if (i >= ECI_SB_MAX_SUBS) {
+        return ECI_SB_ERROR;
+    }
+    sbBus->subs[i].mid  = mid;
+    sbBus->subs[i].pipe = (uint32_t)pipe;
+    atomic_store_explicit(&sbBus->subs[i].valid, 1, memory_order_release);
+    return ECI_SB_SUCCESS;
+}
+
+/* Function: ECI_SB_Enqueue ===============================================
+ * Abstract:
+ *   Claims the next free slot of the pipe and fills it.  Returns
+ *   ECI_SB_PIPE_FULL (and counts a drop) when the consumer is behind by
+ *   a full ring.
+ */
+static int ECI_SB_Enqueue(ECI_SB_Pipe_t *pipe, uint32_t mid,
+                          const void *msg, size_t size, uint64_t sendNs)
+{
+    ECI_SB_Slot_t *slot;
+    uint64_t       pos = atomic_load_explicit(&pipe->head, memory_order_relaxed);
+
+    for (;;) {
+        uint64_t seq;
+        int64_t  diff;
+
+        slot = &pipe->slots[pos & ECI_SB_SLOT_MASK];
+        seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        diff = (int64_t)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&pipe->head, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            atomic_fetch_add_explicit(&pipe->drops, 1, memory_order_relaxed);
+            return ECI_SB_PIPE_FULL;
+        } else {
+            pos = atomic_load_explicit(&pipe->head, memory_order_relaxed);
+        }
+    }
+
+    slot->mid    = mid;
+    slot->size   = (uint32_t)size;
+    slot->sendNs = sendNs;
+    memcpy(slot->data, msg, size);
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return ECI_SB_SUCCESS;
+}
+
+/* Function: ECI_SB_Send ==================================================
+ * Abstract:
+ *   Copies the message to every pipe subscribed to its MID.
+ */
+int ECI_SB_Send(uint32_t mid, const void *msg, size_t size)
+{
+    uint32_t i;
+    uint32_t n;
+    int      status    = ECI_SB_SUCCESS;
+    int      delivered = 0;
+    uint64_t now;
+
+    if (sbBus == NULL) {
+        return ECI_SB_ERROR;
+    }
+    if (size > ECI_SB_MAX_MSG_SIZE) {
+        return ECI_SB_MSG_TOO_LONG;
+    }
+
+    now = ECI_SB_NowNs();
+    n   = atomic_load_explicit(&sbBus->numSubs, memory_order_acquire);
+    for (i = 0; i < n && i < ECI_SB_MAX_SUBS; i++) {
+        ECI_SB_Sub_t *sub = &sbBus->subs[i];
+        if (atomic_load_explicit(&sub->valid, memory_order_acquire) && sub->mid == mid) {
+            if (ECI_SB_Enqueue(&sbBus->pipes[sub->pipe], mid, msg, size, now) != ECI_SB_SUCCESS) {
+                status = ECI_SB_PIPE_FULL;
+            }
+            delivered = 1;
+        }
+    }
+    if (!delivered) {
+        atomic_fetch_add_explicit(&sbBus->noSubscriber, 1, memory_order_relaxed);
+    }
+    return status;
+}
+
+/* Function: ECI_SB_Receive ===============================================
+ * Abstract:
+ *   Takes the oldest message of the pipe without waiting.  Returns
+ *   ECI_SB_NO_MESSAGE when the pipe is empty.  Only the process that
+ *   created the pipe may receive from it.
+ */
+int ECI_SB_Receive(int pipeId, uint32_t *mid, void *buf, size_t bufSize, size_t *size)
+{
+    ECI_SB_Pipe_t *pipe;
+    ECI_SB_Slot_t *slot;
+    uint64_t       pos;
+    uint64_t       lat;
+    uint64_t       max;
+    int            status = ECI_SB_SUCCESS;
+
+    if (sbBus == NULL || pipeId < 0 || pipeId >= ECI_SB_MAX_PIPES) {
+        return ECI_SB_ERROR;
+    }
+    pipe = &sbBus->pipes[pipeId];
+    pos  = atomic_load_explicit(&pipe->tail, memory_order_relaxed);
+    slot = &pipe->slots[pos & ECI_SB_SLOT_MASK];
+
+    if (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos + 1) {
+        return ECI_SB_NO_MESSAGE;
+    }
+
+    *mid  = slot->mid;
+    *size = slot->size;
+    if (slot->size <= bufSize) {
+        memcpy(buf, slot->data, slot->size);
+    } else {
+        status = ECI_SB_MSG_TOO_LONG;
+    }
+
+    lat = ECI_SB_NowNs() - slot->sendNs;
+    atomic_fetch_add_explicit(&pipe->received, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&pipe->latSumNs, lat, memory_order_relaxed);
+    max = atomic_load_explicit(&pipe->latMaxNs, memory_order_relaxed);
+    while (lat > max &&
+           !atomic_compare_exchange_weak_explicit(&pipe->latMaxNs, &max, lat,
+                memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    /* free the slot for the producers' next lap */
+    atomic_store_explicit(&slot->seq, pos + ECI_SB_PIPE_DEPTH, memory_order_release);
+    atomic_store_explicit(&pipe->tail, pos + 1, memory_order_relaxed);
+    return status;
+}
+
+/* Function: ECI_SB_SubscribeTable ========================================
+ * Abstract:
+ *   Subscribes the pipe to each MID of an ECI_MsgRcv table.
+ */
+int ECI_SB_SubscribeTable(int pipe, const ECI_Msg_t *rcvTbl)
+{
+    const ECI_Msg_t *msg;
+
+    for (msg = rcvTbl; msg->mptr != NULL; msg++) {
+        if (ECI_SB_Subscribe((uint32_t)msg->mid, pipe) != ECI_SB_SUCCESS) {
+            return ECI_SB_ERROR;
+        }
+    }
+    return ECI_SB_SUCCESS;
+}
+
+/* Function: ECI_SB_ReceiveTable ==========================================
+ * Abstract:
+ *   Drains the pipe into the ECI_MsgRcv buffers.  Returns the number of
+ *   messages received.  Command queues (qptr) are not used: like
+ *   telemetry, the latest command of each MID is left in mptr.
+ */
+int ECI_SB_ReceiveTable(int pipe, const ECI_Msg_t *rcvTbl)
+{
+    static uint8_t   buf[ECI_SB_MAX_MSG_SIZE];
+    const ECI_Msg_t *msg;
+    uint32_t         mid;
+    size_t           size;
+    int              count = 0;
+
+    while (ECI_SB_Receive(pipe, &mid, buf, sizeof(buf), &size) != ECI_SB_NO_MESSAGE) {
+        count++;
+        for (msg = rcvTbl; msg->mptr != NULL; msg++) {
+            if ((uint32_t)msg->mid == mid) {
+                memcpy(msg->mptr, buf, (size < msg->siz) ? size : msg->siz);
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+/* Function: ECI_SB_SendTable =============================================
+ * Abstract:
+ *   Sends the ECI_MsgSnd entries that are unconditional or flagged.
+ *   Returns the number of messages sent.
+ */
+int ECI_SB_SendTable(const ECI_Msg_t *sndTbl)
+{
+    const ECI_Msg_t *msg;
+    int              count = 0;
+
+    for (msg = sndTbl; msg->mptr != NULL; msg++) {
+        if (msg->sendMsg == NULL || *msg->sendMsg) {
+            ECI_SB_Send((uint32_t)msg->mid, msg->mptr, msg->siz);
+            count++;
+        }
+    }
+    return count;
+}
+
+/* Function: ECI_SB_GetStats ==============================================
+ * Abstract:
+ *   Snapshot of the statistics of a pipe.
+ */
+int ECI_SB_GetStats(int pipeId, ECI_SB_Stats_t *stats)
+{
+    ECI_SB_Pipe_t *pipe;
+
+    if (sbBus == NULL || pipeId < 0 || pipeId >= ECI_SB_MAX_PIPES) {
+        return ECI_SB_ERROR;
+    }
+    pipe = &sbBus->pipes[pipeId];
+    if (!atomic_load_explicit(&pipe->inUse, memory_order_acquire)) {
+        return ECI_SB_ERROR;
+    }
+    memcpy(stats->name, pipe->name, ECI_SB_PIPE_NAME_LEN);
+    stats->received = atomic_load(&pipe->received);
+    stats->drops    = atomic_load(&pipe->drops);
+    stats->latSumNs = atomic_load(&pipe->latSumNs);
+    stats->latMaxNs = atomic_load(&pipe->latMaxNs);
+    return ECI_SB_SUCCESS;
+}
+
+/* Function: ECI_SB_NoSubscriberCount =====================================
+ * Abstract:
+ *   Messages sent with no subscriber for their MID.
+ */
+uint64_t ECI_SB_NoSubscriberCount(void)
+{
+    return (sbBus != NULL) ? atomic_load(&sbBus->noSubscriber) : 0;
+}
+
+/* Function: ECI_SB_PrintStats ============================================
+ * Abstract:
+ *   One line per pipe: messages per second, drops per second and mean and
+ *   max latency over the interval.
+ */
+void ECI_SB_PrintStats(FILE *out, ECI_SB_Stats_t *prev, double intervalSec)
+{
+    int            i;
+    ECI_SB_Stats_t cur;
+
+    for (i = 0; i < ECI_SB_MAX_PIPES; i++) {
+        if (ECI_SB_GetStats(i, &cur) != ECI_SB_SUCCESS) {
+            continue;
+        }
+        /* max latency of this interval: take it and start the next one */
+        cur.latMaxNs = atomic_exchange(&sbBus->pipes[i].latMaxNs, 0);
+        {
+            uint64_t rcv  = cur.received - prev[i].received;
+            uint64_t drop = cur.drops - prev[i].drops;
+            double   mean = (rcv > 0) ?
+                (double)(cur.latSumNs - prev[i].latSumNs) / (double)rcv / 1000.0 : 0.0;
+            fprintf(out, "%-*s %10.0f msg/s %8.0f drop/s  lat mean %8.1f us  max %8.1f us\n",
+                    ECI_SB_PIPE_NAME_LEN, cur.name,
+                    (double)rcv / intervalSec, (double)drop / intervalSec,
+                    mean, (double)cur.latMaxNs / 1000.0);
+        }
+        prev[i] = cur;
+    }
+    fprintf(out, "no subscriber: %llu\n", (unsigned long long)ECI_SB_NoSubscriberCount());
+}
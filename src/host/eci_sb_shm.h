@@ -0,0 +1,97 @@
+/**
+ * eci_sb_shm.h
+ *
+ *    ABSTRACT:
+ *      Shared memory software bus stand-in for running several SIL
+ *      generated apps as separate processes on one Linux host, without
+ *      cFE.  Each process attaches to a named bus, creates a pipe,
+ *      subscribes to the MIDs of its ECI_MsgRcv table and sends its
+ *      ECI_MsgSnd table every step.
+ *
+ *      Pipes are bounded lock-free multi-producer rings in the shared
+ *      segment (per-slot sequence numbers), so senders never block: a
+ *      message to a full pipe is dropped and counted.  Each pipe keeps
+ *      received, dropped and end-to-end latency (send to receive,
+ *      CLOCK_MONOTONIC) statistics.
+ *
+ */
+
+#ifndef ECI_SB_SHM_H
+#define ECI_SB_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "eci_app.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ECI_SB_MAX_PIPES
+#define ECI_SB_MAX_PIPES     32
+#endif
+#ifndef ECI_SB_MAX_SUBS
+#define ECI_SB_MAX_SUBS      512
+#endif
+#ifndef ECI_SB_PIPE_DEPTH
+#define ECI_SB_PIPE_DEPTH    64     /* slots per pipe, power of 2 */
+#endif
+#ifndef ECI_SB_MAX_MSG_SIZE
+#define ECI_SB_MAX_MSG_SIZE  2048   /* bytes, including the header */
+#endif
+#define ECI_SB_PIPE_NAME_LEN 32
+
+/* Return codes */
+#define ECI_SB_SUCCESS        0
+#define ECI_SB_NO_MESSAGE     1
+#define ECI_SB_ERROR         -1
+#define ECI_SB_PIPE_FULL     -2
+#define ECI_SB_MSG_TOO_LONG  -3
+
+/* Pipe statistics, as returned by ECI_SB_GetStats */
+typedef struct {
+    char     name[ECI_SB_PIPE_NAME_LEN];
+    uint64_t received;      /* messages received from the pipe */
+    uint64_t drops;         /* messages dropped, pipe full */
+    uint64_t latSumNs;      /* sum of send to receive latencies */
+    uint64_t latMaxNs;      /* largest latency since the last
+                               ECI_SB_PrintStats */
+} ECI_SB_Stats_t;
+
+/* Attach to (or, when create is non-zero, create) the bus shared memory
+ * segment /eci_sb_<busName>.  Must be called once per process. */
+int  ECI_SB_Attach(const char *busName, int create);
+void ECI_SB_Detach(void);
+/* Remove the shared memory segment of a bus */
+int  ECI_SB_Unlink(const char *busName);
+
+/* Create a pipe, or find the pipe of that name.  Returns the pipe id. */
+int  ECI_SB_CreatePipe(const char *name);
+int  ECI_SB_Subscribe(uint32_t mid, int pipe);
+
+int  ECI_SB_Send(uint32_t mid, const void *msg, size_t size);
+int  ECI_SB_Receive(int pipe, uint32_t *mid, void *buf, size_t bufSize, size_t *size);
+
+/* ECI table helpers.  SubscribeTable subscribes the pipe to each MID of
+ * an ECI_MsgRcv table; ReceiveTable drains the pipe, copying each message
+ * to the mptr of its ECI_MsgRcv entry (the latest one wins); SendTable
+ * sends each ECI_MsgSnd entry with no sendMsg flag or a set flag. */
+int  ECI_SB_SubscribeTable(int pipe, const ECI_Msg_t *rcvTbl);
+int  ECI_SB_ReceiveTable(int pipe, const ECI_Msg_t *rcvTbl);
+int  ECI_SB_SendTable(const ECI_Msg_t *sndTbl);
+
+int  ECI_SB_GetStats(int pipe, ECI_SB_Stats_t *stats);
+/* Messages sent to MIDs with no subscriber */
+uint64_t ECI_SB_NoSubscriberCount(void);
+/* Print the statistics of every pipe.  Rates are computed against prev
+ * (ECI_SB_MAX_PIPES entries, zeroed before the first call) taken
+ * intervalSec earlier, and prev is updated to the current counts. */
+void ECI_SB_PrintStats(FILE *out, ECI_SB_Stats_t *prev, double intervalSec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECI_SB_SHM_H */
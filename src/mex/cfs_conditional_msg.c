@@ -32,7 +32,11 @@
 #define SIDVAL(S)       (ssGetSFcnParam(S,SIDVAL_IDX))
 #define SIDVAL_VAL(S)   (mxGetScalar(ssGetSFcnParam(S,SIDVAL_IDX)))
 
-#define NPARAMS 2
+#define ZEROCOPY_IDX 2
+#define ZEROCOPY(S)     (ssGetSFcnParam(S,ZEROCOPY_IDX))
+#define ZEROCOPY_VAL(S) (mxGetScalar(ssGetSFcnParam(S,ZEROCOPY_IDX)))
+
+#define NPARAMS 3
 
 #define IS_REAL(pVal) (mxIsNumeric(pVal) && !mxIsLogical(pVal) &&\
 !mxIsEmpty(pVal) && !mxIsSparse(pVal) && !mxIsComplex(pVal) && mxIsDouble(pVal))
@@ -54,7 +58,13 @@
  */
 static void mdlCheckParameters(SimStruct *S)
 {
-    /* no parameter checking needed */
+    /* Only the zero copy option needs checking */
+    if (mxGetNumberOfElements(ZEROCOPY(S)) != 1 || mxIsComplex(ZEROCOPY(S)) ||
+            !(mxIsNumeric(ZEROCOPY(S)) || mxIsLogical(ZEROCOPY(S))) ||
+            (ZEROCOPY_VAL(S) != 0.0 && ZEROCOPY_VAL(S) != 1.0)) {
+        ssSetErrorStatus(S,"Zero copy parameter must be 0 (off) or 1 (on)");
+        return;
+    }
 }
 #endif
 
@@ -87,7 +97,7 @@ static void mdlInitializeSizes(SimStruct *S)
     char_T            *flagDwName = "cmsgFlag_";
     
     /* Number of expected parameters */
-    ssSetNumSFcnParams(S, 2);
+    ssSetNumSFcnParams(S, NPARAMS);
 
     #if defined(MATLAB_MEX_FILE) 
     if (ssGetNumSFcnParams(S) == ssGetSFcnParamsCount(S)) {
@@ -109,6 +119,7 @@ static void mdlInitializeSizes(SimStruct *S)
     /* Set the parameter's tunability */
     ssSetSFcnParamTunable(S, MSGBUS_IDX, SS_PRM_NOT_TUNABLE);
     ssSetSFcnParamTunable(S, SIDVAL_IDX, SS_PRM_NOT_TUNABLE);     
+    ssSetSFcnParamTunable(S, ZEROCOPY_IDX, SS_PRM_NOT_TUNABLE);
 
     /* Set the number of work vectors */
     ssSetNumPWork(S, 0);
@@ -185,6 +196,13 @@ static void mdlInitializeSizes(SimStruct *S)
     ssSetBusInputAsStruct(S, BUS_IN_IDX,1);
     ssSetInputPortBusMode(S, BUS_IN_IDX, SL_BUS_MODE);    /*Input Port 1 */
 
+    /* In zero copy mode the CFS Send Table points at the input bus
+     * itself, so it must have its own persistent global storage.
+     */
+    if (ZEROCOPY_VAL(S) != 0) {
+        ssSetInputPortOptimOpts(S, BUS_IN_IDX, SS_NOT_REUSABLE_AND_GLOBAL);
+    }
+
     /* Set the number of output ports */
     if (!ssSetNumOutputPorts(S, 1)) return;
 
@@ -298,7 +316,7 @@ static void mdlInitializeSampleTimes(SimStruct *S)
     
 }
 
-#undef MDL_SET_WORK_WIDTHS
+#define MDL_SET_WORK_WIDTHS
 #if defined(MDL_SET_WORK_WIDTHS) && defined(MATLAB_MEX_FILE)
 /* Function: mdlSetWorkWidths =============================================
  * Abstract:
@@ -315,7 +333,9 @@ static void mdlSetWorkWidths(SimStruct *S)
      * block TLC.
      */
     /* Set number of run-time parameters */
-    if (!ssSetNumRunTimeParams(S, 0)) return;       
+    if (!ssSetNumRunTimeParams(S, 1)) return;       
+
+    ssRegDlgParamAsRunTimeParam(S, ZEROCOPY_IDX, 0, "cmsg_zerocopy", ssGetDataTypeId(S, "boolean"));
 }
 #endif
 
@@ -22,11 +22,20 @@
  * its associated macro definitions.
  */
 #include "simstruc.h"
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
 
 #define U(element) (*uPtrs[element])  /* Pointer to Input Port0 */
 
 #define FLAG_IDX        0
 #define DATA_IDX_START  1
+#define MAX_DATA_PORTS  5
+
+/* ssSetDWorkName keeps the pointer, so the names must outlive the call */
+static const char *dataDWorkNames[MAX_DATA_PORTS] = {
+    "eventData1", "eventData2", "eventData3", "eventData4", "eventData5"
+};
 
 /* Event ID Parm */
 #define EVID_IDX 0
@@ -53,7 +62,29 @@
 #define SIDVAL(S)       (ssGetSFcnParam(S,SIDVAL_IDX))
 #define SIDVAL_VAL(S)   (mxGetScalar(ssGetSFcnParam(S,SIDVAL_IDX)))
 
-#define NPARAMS 6  /* number of block mask parms */
+/* Trigger mode (1 = level, 2 = rising edge) */
+#define TRIGMODE_IDX 6
+#define TRIGMODE(S)     (ssGetSFcnParam(S,TRIGMODE_IDX))
+#define TRIGMODE_VAL(S) (mxGetScalar(ssGetSFcnParam(S,TRIGMODE_IDX)))
+/* Rate limit burst size (0 = no rate limit) */
+#define BURST_IDX 7
+#define BURST(S)        (ssGetSFcnParam(S,BURST_IDX))
+#define BURST_VAL(S)    (mxGetScalar(ssGetSFcnParam(S,BURST_IDX)))
+/* Rate limit refill period (block steps per token) */
+#define PERIOD_IDX 8
+#define PERIOD(S)       (ssGetSFcnParam(S,PERIOD_IDX))
+#define PERIOD_VAL(S)   (mxGetScalar(ssGetSFcnParam(S,PERIOD_IDX)))
+
+#define NPARAMS 9  /* number of block mask parms */
+
+#define TRIG_LEVEL  1
+#define TRIG_RISING 2
+
+/* DWork index of the suppressed event counter (after the data DWorks) */
+#define SUPP_DWORK(nData)    ((nData)+1)
+
+#define IS_EDGE_TRIGGERED(S) ((int)TRIGMODE_VAL(S) == TRIG_RISING)
+#define IS_RATE_LIMITED(S)   (BURST_VAL(S) > 0)
 
 #define IS_REAL(pVal) (mxIsNumeric(pVal) && !mxIsLogical(pVal) &&\
 !mxIsEmpty(pVal) && !mxIsSparse(pVal) && !mxIsComplex(pVal) && mxIsDouble(pVal))
@@ -76,7 +107,7 @@
 static void mdlCheckParameters(SimStruct *S)
 {
     int       prm;
-    long      lprm;
+    real_T    dprm;     /* checked as a double: long is 32 bit on Windows */
     size_t    nu;
     boolean_T illegalParam = 0;
     
@@ -111,8 +142,8 @@ static void mdlCheckParameters(SimStruct *S)
         
         /* Check the parameter 3: Event Mask */
         if (IS_INT(EVMASK(S))) {
-            lprm = (long)EVMASK_VAL(S);
-            if (lprm < 0 || lprm > 4294967295) { /* 2^32-1 */
+            dprm = EVMASK_VAL(S);
+            if (dprm < 0.0 || dprm > (real_T)UINT32_MAX) {
                 ssSetErrorStatus(S,"Event Mask parameter must be between "
                         "0 and 2^32-1");
                 return;
@@ -151,6 +182,48 @@ static void mdlCheckParameters(SimStruct *S)
         }
         /* No check needed on Parameter 6 (SID parm).  Value is 
          * string set by mask. */
+
+        /* Check the parameter 7: Trigger mode */
+        if (IS_REAL(TRIGMODE(S))) {
+            prm = (int)TRIGMODE_VAL(S);
+            if (prm != TRIG_LEVEL && prm != TRIG_RISING) {
+                ssSetErrorStatus(S,"Event trigger mode must be 1 (level) "
+                        "or 2 (rising edge)");
+                return;
+            }
+        }
+        else {
+            ssSetErrorStatus(S,"Event trigger mode must be integer");
+            return;
+        }
+
+        /* Check the parameter 8: Rate limit burst size */
+        if (IS_REAL(BURST(S)) || IS_INT(BURST(S))) {
+            dprm = BURST_VAL(S);
+            if (dprm < 0.0 || dprm > 65535.0 || dprm != floor(dprm)) {
+                ssSetErrorStatus(S,"Event rate limit burst must be an integer "
+                        "between 0 (no limit) and 65535");
+                return;
+            }
+        }
+        else {
+            ssSetErrorStatus(S,"Event rate limit burst must be integer");
+            return;
+        }
+
+        /* Check the parameter 9: Rate limit refill period */
+        if (IS_REAL(PERIOD(S)) || IS_INT(PERIOD(S))) {
+            dprm = PERIOD_VAL(S);
+            if (dprm < 1.0 || dprm > (real_T)UINT32_MAX || dprm != floor(dprm)) {
+                ssSetErrorStatus(S,"Event rate limit period must be an integer "
+                        "number of steps between 1 and 2^32-1");
+                return;
+            }
+        }
+        else {
+            ssSetErrorStatus(S,"Event rate limit period must be integer");
+            return;
+        }
     }
 }
 #endif
@@ -180,13 +253,16 @@ static void mdlInitializeSizes(SimStruct *S)
     char              *buf;
     char              *flagDwBuf;
     char              *dataDwBuf;
+    char              *suppDwBuf;
     char              *flagDwName = "evFlag_";
-    char              *dataName   = "evData_";
+    char              *dataName   = "evData";
+    char              *suppDwName = "evSupp_";
+    int_T              nDWork;
     
     const mxArray*     prm1;
   
     /* Number of expected parameters */
-    ssSetNumSFcnParams(S, 6);
+    ssSetNumSFcnParams(S, NPARAMS);
 
     #if defined(MATLAB_MEX_FILE) 
     if (ssGetNumSFcnParams(S) == ssGetSFcnParamsCount(S)) {
@@ -211,6 +287,9 @@ static void mdlInitializeSizes(SimStruct *S)
     ssSetSFcnParamTunable(S, EVFORMAT_IDX, 0);
     ssSetSFcnParamTunable(S, NUMDATA_IDX,  0);
     ssSetSFcnParamTunable(S, SIDVAL_IDX,   0);  
+    ssSetSFcnParamTunable(S, TRIGMODE_IDX, 0);
+    ssSetSFcnParamTunable(S, BURST_IDX,    0);
+    ssSetSFcnParamTunable(S, PERIOD_IDX,   0);
 
     /* Set the number of input ports dynamically */
     prm1 = ssGetSFcnParam(S, NUMDATA_IDX); 
@@ -226,9 +305,12 @@ static void mdlInitializeSizes(SimStruct *S)
     ssSetInputPortRequiredContiguous(S, FLAG_IDX, 1);
     ssSetInputPortOptimOpts(S, FLAG_IDX, SS_NOT_REUSABLE_AND_GLOBAL);  
 
-    /* Configure the Data input ports  */
+    /* Configure the Data input ports.  Data types are inherited so
+     * that integer, single and boolean signals do not need conversion
+     * blocks (see mdlSetInputPortDataType for the accepted types).
+     */
     for(i=1; i < nDataPorts+1; i++) {
-        ssSetInputPortDataType(S, i, SS_DOUBLE);
+        ssSetInputPortDataType(S, i, DYNAMICALLY_TYPED);
         ssSetInputPortWidth(S, i, 1);
         ssSetInputPortComplexSignal(S, i, COMPLEX_NO);
         ssSetInputPortDirectFeedThrough(S, i, 1); 
@@ -241,17 +323,41 @@ static void mdlInitializeSizes(SimStruct *S)
     
     /* Set up DWork for persistent storage of Event flag and
      * data inputs.  This is needed when this block is used
-     * in reusable subsystems. Note: max 5 scalar data inputs
-     * for blocks will be stored in contiguous DWork array.
+     * in reusable subsystems. Note: each scalar data input is
+     * stored in its own DWork with the data type of its port
+     * (set in mdlSetWorkWidths once port types are resolved).
+     */
+    /* After the data DWorks come the suppressed event counter and, 
+     * depending on the trigger/rate limit options, the previous flag
+     * value and the token bucket state (tokens, refill step counter).
      */
-    if (nDataPorts > 0) {
-        ssSetNumDWork(S, 2);
-        ssSetDWorkWidth(S, 1, 5);   /* block max is 5 scalars */
-        ssSetDWorkDataType(S, 1, SS_DOUBLE);
-        ssSetDWorkName(S, 1, "eventData");
+    nDWork = SUPP_DWORK(nDataPorts) + 1;
+    if (IS_EDGE_TRIGGERED(S)) nDWork++;
+    if (IS_RATE_LIMITED(S))   nDWork += 2;
+    if (!ssSetNumDWork(S, nDWork)) return;
+    for(i=1; i < nDataPorts+1; i++) {
+        ssSetDWorkWidth(S, i, 1);
+        ssSetDWorkDataType(S, i, DYNAMICALLY_TYPED);
+        ssSetDWorkName(S, i, dataDWorkNames[i-1]);
+    }
+    i = SUPP_DWORK(nDataPorts);
+    ssSetDWorkWidth(S, i, 1);
+    ssSetDWorkDataType(S, i, SS_UINT32);
+    ssSetDWorkName(S, i, "eventSuppressed");
+    i++;
+    if (IS_EDGE_TRIGGERED(S)) {
+        ssSetDWorkWidth(S, i, 1);
+        ssSetDWorkDataType(S, i, SS_BOOLEAN);
+        ssSetDWorkName(S, i, "eventPrevFlag");
+        i++;
     }
-    else {
-        ssSetNumDWork(S, 1);
+    if (IS_RATE_LIMITED(S)) {
+        ssSetDWorkWidth(S, i, 1);
+        ssSetDWorkDataType(S, i, SS_UINT32);
+        ssSetDWorkName(S, i, "eventTokens");
+        ssSetDWorkWidth(S, i+1, 1);
+        ssSetDWorkDataType(S, i+1, SS_UINT32);
+        ssSetDWorkName(S, i+1, "eventRefill");
     }
     ssSetDWorkWidth(S, 0, 1);      
     ssSetDWorkDataType(S, 0, SS_BOOLEAN);
@@ -272,17 +378,10 @@ static void mdlInitializeSizes(SimStruct *S)
         return;
     }
         
-    if ((dataDwBuf = malloc(buflen+sizeof(dataName))) == NULL) {
-        ssSetErrorStatus(S,"Memory allocation error for data input name string");
-        return;
-    }
-         
     mxGetString(SIDVAL(S), buf, buflen); /* Get the SID string */
     
     /* append SID to global variable names */
     strcpy(flagDwBuf,flagDwName);
-    strcpy(dataDwBuf,dataName);    
-    strcat(dataDwBuf,buf); /* add SID as suffix */   
     strcat(flagDwBuf,buf); /* add SID as suffix */
 
     /* make dwork to store the flag input for this
@@ -294,10 +393,29 @@ static void mdlInitializeSizes(SimStruct *S)
      * ability to access its address for CFS data structures.
      */
     ssSetDWorkRTWStorageClass(S, 0, SS_RTW_STORAGE_EXPORTED_GLOBAL); 
-    if (nDataPorts > 0) {
-        ssSetDWorkRTWIdentifier(S, 1, dataDwBuf);  
-        ssSetDWorkRTWStorageClass(S, 1, SS_RTW_STORAGE_EXPORTED_GLOBAL); 
+
+    /* Data input DWork is named evData<port>_<SID> (e.g. evData1_<SID>) */
+    for(i=1; i < nDataPorts+1; i++) {
+        /* "evData" + up to 1 digit + "_" + SID + null */
+        if ((dataDwBuf = malloc(strlen(dataName)+buflen+2)) == NULL) {
+            ssSetErrorStatus(S,"Memory allocation error for data input name string");
+            return;
+        }
+        sprintf(dataDwBuf, "%s%d_%s", dataName, i, buf);
+        ssSetDWorkRTWIdentifier(S, i, dataDwBuf);  
+        ssSetDWorkRTWStorageClass(S, i, SS_RTW_STORAGE_EXPORTED_GLOBAL); 
+    }
+
+    /* Suppressed event counter is exported (evSupp_<SID>) so that its
+     * address can be stored in the CFS Event Table for housekeeping. */
+    if ((suppDwBuf = malloc(buflen+strlen(suppDwName))) == NULL) {
+        ssSetErrorStatus(S,"Memory allocation error for suppressed count name string");
+        return;
     }
+    strcpy(suppDwBuf,suppDwName);
+    strcat(suppDwBuf,buf); /* add SID as suffix */
+    ssSetDWorkRTWIdentifier(S, SUPP_DWORK(nDataPorts), suppDwBuf);
+    ssSetDWorkRTWStorageClass(S, SUPP_DWORK(nDataPorts), SS_RTW_STORAGE_EXPORTED_GLOBAL);
     
     free(buf);  /* other malloc'd mem freed in mdlTeminate() */
            
@@ -345,6 +463,63 @@ static void mdlInitializeSampleTimes(SimStruct *S)
     #endif
 }
 
+#define MDL_SET_INPUT_PORT_DATA_TYPE
+#if defined(MDL_SET_INPUT_PORT_DATA_TYPE) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetInputPortDataType ======================================
+ * Abstract:
+ *   Accept the built-in numeric types (and boolean) on the data input
+ *   ports.  The flag port is always boolean.  The data type of each
+ *   port is also used for its DWork so that the value is stored (and
+ *   referenced by the CFS Event table) in its native type.
+ */
+static void mdlSetInputPortDataType(SimStruct *S, int_T port, DTypeId id)
+{
+    if (port == FLAG_IDX) {
+        if (id != SS_BOOLEAN) {
+            ssSetErrorStatus(S,"Event flag input must be boolean");
+            return;
+        }
+    } else {
+        switch (id) {
+            case SS_DOUBLE:
+            case SS_SINGLE:
+            case SS_INT8:
+            case SS_UINT8:
+            case SS_INT16:
+            case SS_UINT16:
+            case SS_INT32:
+            case SS_UINT32:
+            case SS_BOOLEAN:
+                break;
+            default:
+                ssSetErrorStatus(S,"Event data inputs must be a built-in "
+                        "real scalar type (double, single, int8-32, "
+                        "uint8-32 or boolean)");
+                return;
+        }
+    }
+    ssSetInputPortDataType(S, port, id);
+}
+#endif
+
+#define MDL_SET_DEFAULT_PORT_DATA_TYPES
+#if defined(MDL_SET_DEFAULT_PORT_DATA_TYPES) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetDefaultPortDataTypes ===================================
+ * Abstract:
+ *   Data inputs that could not be resolved from the model default to
+ *   double (the type used by previous versions of this block).
+ */
+static void mdlSetDefaultPortDataTypes(SimStruct *S)
+{
+    int_T i;
+    for(i=DATA_IDX_START; i < ssGetNumInputPorts(S); i++) {
+        if (ssGetInputPortDataType(S, i) == DYNAMICALLY_TYPED) {
+            ssSetInputPortDataType(S, i, SS_DOUBLE);
+        }
+    }
+}
+#endif
+
 #define MDL_SET_WORK_WIDTHS
 #if defined(MDL_SET_WORK_WIDTHS) && defined(MATLAB_MEX_FILE)
 /* Function: mdlSetWorkWidths =============================================
@@ -369,11 +544,17 @@ static void mdlSetWorkWidths(SimStruct *S)
     const  mwSize *dims;
     int_T         *tmpDims;
 
+    /* Each data DWork stores its input in the port's native type */
+    for(i=DATA_IDX_START; i < (mwSize)ssGetNumInputPorts(S); i++) {
+        ssSetDWorkDataType(S, i, ssGetInputPortDataType(S, i));
+    }
+    i = 0;
+
     /* Set the paramters as run-time so we can get this information in 
      * block TLC.
      */
     /* Set number of run-time parameters */
-    if (!ssSetNumRunTimeParams(S, 6)) return;
+    if (!ssSetNumRunTimeParams(S, 8)) return;
 
     ssRegDlgParamAsRunTimeParam(S, EVID_IDX, 0,   "event_id",   ssGetDataTypeId(S, "uint8"));
     ssRegDlgParamAsRunTimeParam(S, EVTYPE_IDX, 1, "event_type", ssGetDataTypeId(S, "uint8"));
@@ -429,10 +610,195 @@ static void mdlSetWorkWidths(SimStruct *S)
     if (!ssSetRunTimeParamInfo(S, EVFORMAT_IDX, &p)) return;
 
     ssRegDlgParamAsRunTimeParam(S, NUMDATA_IDX, 4, "event_numdata", ssGetDataTypeId(S, "double"));
+    ssRegDlgParamAsRunTimeParam(S, TRIGMODE_IDX, 5, "event_trigger", ssGetDataTypeId(S, "uint8"));
+    ssRegDlgParamAsRunTimeParam(S, BURST_IDX,    6, "event_burst",   ssGetDataTypeId(S, "uint32"));
+    ssRegDlgParamAsRunTimeParam(S, PERIOD_IDX,   7, "event_period",  ssGetDataTypeId(S, "uint32"));
         
 }
 #endif
 
+#define MDL_INITIALIZE_CONDITIONS
+#if defined(MDL_INITIALIZE_CONDITIONS)
+/* Function: mdlInitializeConditions ======================================
+ * Abstract:
+ *   Reset the edge detection and rate limit state.  The token bucket
+ *   starts full so that the first burst of events is not delayed.
+ */
+static void mdlInitializeConditions(SimStruct *S)
+{
+    int_T i = SUPP_DWORK((int_T)NUMDATA_VAL(S));
+
+    *(uint32_T*)ssGetDWork(S, i++) = 0;
+    if (IS_EDGE_TRIGGERED(S)) {
+        *(boolean_T*)ssGetDWork(S, i++) = false;
+    }
+    if (IS_RATE_LIMITED(S)) {
+        *(uint32_T*)ssGetDWork(S, i)   = (uint32_T)BURST_VAL(S);
+        *(uint32_T*)ssGetDWork(S, i+1) = 0;
+    }
+}
+#endif
+
+/* Function: cfsEventFire =================================================
+ * Abstract:
+ *   Apply the trigger mode and token bucket rate limit to the flag input
+ *   and return whether the event is emitted this step.  Mirrors the code
+ *   generated by the block TLC.
+ */
+static boolean_T cfsEventFire(SimStruct *S, boolean_T flag)
+{
+    int_T      i    = SUPP_DWORK((int_T)NUMDATA_VAL(S));
+    uint32_T  *supp = (uint32_T*)ssGetDWork(S, i++);
+    boolean_T  fire = flag;
+
+    if (IS_EDGE_TRIGGERED(S)) {
+        boolean_T *prev = (boolean_T*)ssGetDWork(S, i++);
+        fire  = flag && !(*prev);
+        *prev = flag;
+    }
+    if (IS_RATE_LIMITED(S)) {
+        uint32_T *tokens = (uint32_T*)ssGetDWork(S, i);
+        uint32_T *refill = (uint32_T*)ssGetDWork(S, i+1);
+        if (*tokens < (uint32_T)BURST_VAL(S)) {
+            if (++(*refill) >= (uint32_T)PERIOD_VAL(S)) {
+                *refill = 0;
+                (*tokens)++;
+            }
+        }
+        if (fire) {
+            if (*tokens > 0) {
+                (*tokens)--;
+            } else {
+                fire = false;
+                if (*supp < 0xFFFFFFFFU) (*supp)++;
+            }
+        }
+    }
+    return fire;
+}
+
+/* Function: cfsEventPortValue ===========================================
+ * Abstract:
+ *   Return the value of a scalar data input port as a double.  All of
+ *   the accepted input types are exactly representable as a double.
+ */
+static real_T cfsEventPortValue(SimStruct *S, int_T port)
+{
+    const void *u = ssGetInputPortSignal(S, port);
+
+    switch (ssGetInputPortDataType(S, port)) {
+        case SS_SINGLE:  return (real_T)*(const real32_T*)u;
+        case SS_INT8:    return (real_T)*(const int8_T*)u;
+        case SS_UINT8:   return (real_T)*(const uint8_T*)u;
+        case SS_INT16:   return (real_T)*(const int16_T*)u;
+        case SS_UINT16:  return (real_T)*(const uint16_T*)u;
+        case SS_INT32:   return (real_T)*(const int32_T*)u;
+        case SS_UINT32:  return (real_T)*(const uint32_T*)u;
+        case SS_BOOLEAN: return (real_T)*(const boolean_T*)u;
+        default:         return *(const real_T*)u;
+    }
+}
+
+/* Function: cfsEventIntValue =============================================
+ * Abstract:
+ *   A data input value as a signed integer, saturated to the long long 
+ *   range (NaN gives 0), so that no out of range double is converted.
+ */
+static long long cfsEventIntValue(real_T v)
+{
+    if (v != v) {
+        return 0;
+    }
+    if (v >= 9223372036854775807.0) {
+        return LLONG_MAX;
+    }
+    if (v <= -9223372036854775808.0) {
+        return LLONG_MIN;
+    }
+    return (long long)v;
+}
+
+/* Function: cfsEventFormat ===============================================
+ * Abstract:
+ *   Format the event message one conversion at a time so that each data
+ *   input is passed to snprintf with the argument type its conversion
+ *   specifier expects (long long for d/i, unsigned long long for o/u/x/X,
+ *   converted through long long so negative values wrap as in C, int for
+ *   c, double for e/f/g/a).  The %s conversion (block location) takes the
+ *   SID.  Other conversions are dropped.
+ */
+static void cfsEventFormat(SimStruct *S, char *out, size_t outlen,
+                           const char *fmt, const char *sid)
+{
+    char        spec[32];
+    size_t      n = 0;
+    size_t      k;
+    int_T       port = DATA_IDX_START;
+    int         w;
+
+    while (*fmt != '\0' && n+1 < outlen) {
+        if (*fmt != '%') {
+            out[n++] = *fmt++;
+            continue;
+        }
+        if (fmt[1] == '%') {
+            out[n++] = '%';
+            fmt += 2;
+            continue;
+        }
+
+        /* Copy flags, width and precision; drop any length modifier */
+        k = 0;
+        spec[k++] = *fmt++;
+        while (*fmt != '\0' && strchr("-+ #0123456789.", *fmt) != NULL &&
+               k < sizeof(spec)-4) {
+            spec[k++] = *fmt++;
+        }
+        while (*fmt != '\0' && strchr("hlLqjzt", *fmt) != NULL) {
+            fmt++;
+        }
+        if (*fmt == '\0') break;
+
+        w = 0;
+        if (*fmt == 's') {
+            spec[k++] = 's';
+            spec[k]   = '\0';
+            w = snprintf(out+n, outlen-n, spec, sid);
+        } else if (port < ssGetNumInputPorts(S)) {
+            if (strchr("di", *fmt) != NULL) {
+                spec[k++] = 'l';
+                spec[k++] = 'l';
+                spec[k++] = *fmt;
+                spec[k]   = '\0';
+                w = snprintf(out+n, outlen-n, spec,
+                        cfsEventIntValue(cfsEventPortValue(S, port++)));
+            } else if (strchr("ouxX", *fmt) != NULL) {
+                spec[k++] = 'l';
+                spec[k++] = 'l';
+                spec[k++] = *fmt;
+                spec[k]   = '\0';
+                w = snprintf(out+n, outlen-n, spec, (unsigned long long)
+                        cfsEventIntValue(cfsEventPortValue(S, port++)));
+            } else if (*fmt == 'c') {
+                spec[k++] = 'c';
+                spec[k]   = '\0';
+                w = snprintf(out+n, outlen-n, spec,
+                        (int)cfsEventIntValue(cfsEventPortValue(S, port++)));
+            } else if (strchr("eEfFgGaA", *fmt) != NULL) {
+                spec[k++] = *fmt;
+                spec[k]   = '\0';
+                w = snprintf(out+n, outlen-n, spec,
+                        cfsEventPortValue(S, port++));
+            }
+        }
+        fmt++;
+        if (w > 0) {
+            n += ((size_t)w < outlen-n) ? (size_t)w : outlen-n-1;
+        }
+    }
+    out[n] = '\0';
+}
+
 /* Function: mdlOutputs ===================================================
  * Abstract:
  *   In this function, you compute the outputs of your S-function
@@ -445,13 +811,15 @@ static void mdlOutputs(SimStruct *S, int_T tid)
      * (Block TLC does update this block's DWork persistent
      * data which is stored as pointers in CFS Event table.
      */ 
-    const bool sendFlag = *(bool*)ssGetInputPortSignal(S, FLAG_IDX);
+    const boolean_T sendFlag = cfsEventFire(S,
+            *(const boolean_T*)ssGetInputPortSignal(S, FLAG_IDX));
     if(sendFlag){
         
         /* Get SID string*/
         char *sid_buf;
         int sid_buflen = mxGetN(SIDVAL(S)) + 1;
         sid_buf = malloc(sid_buflen);
+        if (sid_buf == NULL) return;
         mxGetString(SIDVAL(S), sid_buf, sid_buflen);
         
         /* Allocate event string*/
@@ -459,45 +827,14 @@ static void mdlOutputs(SimStruct *S, int_T tid)
         /* Message Length = SID string + length of format string + null term + 
                 fudge factor to account for change in length due to formatting of values
         */
-        int evt_buflen = sid_buflen + strlen(EVFORMAT_VAL(S)) + 1 + 20;
+        int evt_buflen = sid_buflen + strlen(EVFORMAT_VAL(S)) + 1 + 20*MAX_DATA_PORTS;
         evt_buf = malloc(evt_buflen);
-        
-        switch((int)NUMDATA_VAL(S)) { 
-            case 0:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf);
-                break;
-            case 1:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf, 
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START));
-                break;
-            case 2:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf, 
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+1));
-                break;
-            case 3:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf, 
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+1),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+2));
-                break;
-            case 4:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf, 
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+1),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+2),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+3));
-                break;
-            case 5:
-                snprintf(evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf, 
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+1),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+2),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+3),
-                    *ssGetInputPortRealSignal(S, DATA_IDX_START+4));
-                break;
+        if (evt_buf != NULL) {
+            cfsEventFormat(S, evt_buf, evt_buflen, EVFORMAT_VAL(S), sid_buf);
+            //ssPrintf("T=%6.2f: %s \n", ssGetT(S), evt_buf);
+            free(evt_buf);
         }
-        //ssPrintf("T=%6.2f: %s \n", ssGetT(S), evt_buf);
+        free(sid_buf);
     }
 }
 
@@ -511,6 +848,7 @@ static void mdlTerminate(SimStruct *S)
     char  *id;
     int_T *tmpDims;
     int_T nDataPorts;  
+    int_T i;
     const mxArray*     prm1;
    
     prm1 = ssGetSFcnParam(S, NUMDATA_IDX); 
@@ -530,13 +868,18 @@ static void mdlTerminate(SimStruct *S)
         free(id);
     }
     ssSetDWorkRTWIdentifier(S, 0, NULL);
-    if(nDataPorts > 0) {
-        id = ssGetDWorkRTWIdentifier(S, 1);
+    for(i=1; i < nDataPorts+1; i++) {
+        id = ssGetDWorkRTWIdentifier(S, i);
         if (id != NULL) {
             free(id);
         }
-        ssSetDWorkRTWIdentifier(S, 1, NULL);
+        ssSetDWorkRTWIdentifier(S, i, NULL);
     }    
+    id = ssGetDWorkRTWIdentifier(S, SUPP_DWORK(nDataPorts));
+    if (id != NULL) {
+        free(id);
+    }
+    ssSetDWorkRTWIdentifier(S, SUPP_DWORK(nDataPorts), NULL);
 }
 
 /* Required S-function trailer */
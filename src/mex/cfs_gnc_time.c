@@ -5,7 +5,13 @@
  *     The purpose of this sfunction is to get simulation time and
  *     add an offset to it.  Block inline TLC will generate code
  *     to access the GNC timestamp from the CFE and provide it as
- *     a double precision block output.
+ *     a double precision block output, or as uint32 seconds and 
+ *     subseconds (LSB = 2^-32 seconds) for integer-only models.
+ *
+ *     In simulation (including accelerator and rapid accelerator)
+ *     the time can instead be taken from a table of CFE timestamps,
+ *     one row of [seconds subseconds] per block execution, so that
+ *     simulation uses the same quantization as ECI_Step_TimeStamp.
  *
  *
  */
@@ -22,10 +28,33 @@
  * its associated macro definitions.
  */
 #include "simstruc.h"
+#include <math.h>
 #define EDIT_OK(S, P_IDX) \
  (!((ssGetSimMode(S)==SS_SIMMODE_SIZES_CALL_ONLY) && mxIsEmpty(ssGetSFcnParam(S, P_IDX))))
 
 #define SAMPLE_TIME           (ssGetSFcnParam(S,1))
+#define OUTPUT_MODE           (ssGetSFcnParam(S,2))
+#define OUTPUT_MODE_VAL       ((int_T)mxGetScalar(OUTPUT_MODE))
+
+#define TIME_SOURCE           (ssGetSFcnParam(S,3))
+#define TIME_SOURCE_VAL       ((int_T)mxGetScalar(TIME_SOURCE))
+#define TIMESTAMPS            (ssGetSFcnParam(S,4))
+
+#define OUTPUT_DOUBLE         1  /* seconds as real_T */
+#define OUTPUT_SEC_SUBSEC     2  /* uint32 [seconds subseconds] */
+
+#define SOURCE_SIM_TIME       1  /* simulation time + epoch */
+#define SOURCE_TIMESTAMPS     2  /* timestamp table, one row per step */
+
+/* 
+ * The timestamp table and its row index only exist when the table is the
+ * time source of a simulation (normal, accelerator, rapid accelerator or 
+ * model reference simulation target), never in flight code.
+ */
+#define USE_TIMESTAMPS(S) \
+ (TIME_SOURCE_VAL == SOURCE_TIMESTAMPS && \
+  (!ssRTWGenIsCodeGen(S) || ssRTWGenIsAccelerator(S) || \
+   ssRTWGenIsModelReferenceSimTarget(S) || ssIsRapidAcceleratorActive(S)))
 
 #define isDWorkNeeded(S)               ((!((ssRTWGenIsCodeGen(S) || ssGetSimMode(S)==SS_SIMMODE_EXTERNAL) && isSimulationTarget==0)) || ssIsRapidAcceleratorActive(S))
 
@@ -98,6 +127,45 @@ static void mdlCheckParameters(SimStruct *S)
       return;
     }
   }
+  /*
+   * Check the parameter 4 - Time source
+   */
+  if EDIT_OK(S, 3) {
+    if (!IsRealMatrix(TIME_SOURCE) || 
+        mxGetNumberOfElements(TIME_SOURCE) != 1 ||
+        (TIME_SOURCE_VAL != SOURCE_SIM_TIME && 
+         TIME_SOURCE_VAL != SOURCE_TIMESTAMPS)) {
+      ssSetErrorStatus(S,
+                       "Invalid time source. Must be 1 (simulation time) or 2 (timestamp table).");
+      return;
+    }
+  }
+  /*
+   * Check the parameter 5 - Timestamp table [seconds subseconds], only 
+   * used with the timestamp table time source
+   */
+  if (EDIT_OK(S, 3) && EDIT_OK(S, 4) && TIME_SOURCE_VAL == SOURCE_TIMESTAMPS) {
+    if (!mxIsNumeric(TIMESTAMPS) || mxIsComplex(TIMESTAMPS) ||
+        mxIsEmpty(TIMESTAMPS) || mxGetNumberOfDimensions(TIMESTAMPS) != 2 ||
+        mxGetN(TIMESTAMPS) != 2) {
+      ssSetErrorStatus(S,
+                       "Invalid timestamp table. Must be an Nx2 matrix of [seconds subseconds] (see loadCfsTimestamps).");
+      return;
+    }
+  }
+  /*
+   * Check the parameter 3 - Output mode
+   */
+  if EDIT_OK(S, 2) {
+    if (!IsRealMatrix(OUTPUT_MODE) || 
+        mxGetNumberOfElements(OUTPUT_MODE) != 1 ||
+        (OUTPUT_MODE_VAL != OUTPUT_DOUBLE && 
+         OUTPUT_MODE_VAL != OUTPUT_SEC_SUBSEC)) {
+      ssSetErrorStatus(S,
+                       "Invalid output mode. Must be 1 (double) or 2 (uint32 seconds and subseconds).");
+      return;
+    }
+  }
 
 
 }
@@ -127,7 +195,7 @@ static void mdlProcessParameters(SimStruct *S)
 static void mdlInitializeSizes(SimStruct *S)
 {
   /* Number of expected parameters */
-  ssSetNumSFcnParams(S, 2);
+  ssSetNumSFcnParams(S, 5);
 
 #if defined(MATLAB_MEX_FILE)
 
@@ -152,12 +220,25 @@ static void mdlInitializeSizes(SimStruct *S)
   /* Set the parameter's tunability */
   ssSetSFcnParamTunable(S, 0, 1);
   ssSetSFcnParamTunable(S, 1, 0);
+  ssSetSFcnParamTunable(S, 2, 0);
+  ssSetSFcnParamTunable(S, 3, 0);
+  /* timestamps can change per run */
+  ssSetSFcnParamTunable(S, 4, USE_TIMESTAMPS(S) ? 1 : 0);
 
   /*
    * Set the number of work vectors.
    */
-  if (!ssSetNumDWork(S, 0))
-    return;
+  if (USE_TIMESTAMPS(S)) {
+    /* Index of the next row of the timestamp table */
+    if (!ssSetNumDWork(S, 1))
+      return;
+    ssSetDWorkDataType(S, 0, SS_UINT32);
+    ssSetDWorkName(S, 0, "tsIndex");
+    ssSetDWorkWidth(S, 0, 1);
+  } else {
+    if (!ssSetNumDWork(S, 0))
+      return;
+  }
   ssSetNumPWork(S, 0);
 
   /*
@@ -175,11 +256,18 @@ static void mdlInitializeSizes(SimStruct *S)
   /*
    * Configure the output port 1
    */
-  ssSetOutputPortDataType(S, 0, SS_DOUBLE);
-  ssSetOutputPortWidth(S, 0, 1);
+  if (OUTPUT_MODE_VAL == OUTPUT_SEC_SUBSEC) {
+    /* [seconds subseconds] straight from the CFE timestamp */
+    ssSetOutputPortDataType(S, 0, SS_UINT32);
+    ssSetOutputPortWidth(S, 0, 2);
+  } else {
+    ssSetOutputPortDataType(S, 0, SS_DOUBLE);
+    ssSetOutputPortWidth(S, 0, 1);
+    ssSetOutputPortOutputExprInRTW(S, 0, 
+        (TIME_SOURCE_VAL == SOURCE_SIM_TIME));
+  }
   ssSetOutputPortComplexSignal(S, 0, COMPLEX_NO);
   ssSetOutputPortOptimOpts(S, 0, SS_REUSABLE_AND_LOCAL);
-  ssSetOutputPortOutputExprInRTW(S, 0, 1);
 
   /*
    * Register reserved identifiers to avoid name conflict
@@ -266,13 +354,26 @@ static void mdlInitializeSampleTimes(SimStruct *S)
 static void mdlSetWorkWidths(SimStruct *S)
 {
   /* Set number of run-time parameters */
-  if (!ssSetNumRunTimeParams(S, 1))
+  if (!ssSetNumRunTimeParams(S, USE_TIMESTAMPS(S) ? 4 : 3))
     return;
 
   /*
    * Register the run-time parameter 1
    */
   ssRegDlgParamAsRunTimeParam(S, 0, 0, "p1", ssGetDataTypeId(S, "double"));
+
+  /*
+   * Register the output mode (non-tunable) so block TLC can read it
+   */
+  ssRegDlgParamAsRunTimeParam(S, 2, 1, "outmode", ssGetDataTypeId(S, "double"));
+
+  /*
+   * Register the time source and the (tunable) timestamp table
+   */
+  ssRegDlgParamAsRunTimeParam(S, 3, 2, "timesrc", ssGetDataTypeId(S, "double"));
+  if (USE_TIMESTAMPS(S)) {
+    ssRegDlgParamAsRunTimeParam(S, 4, 3, "tstamps", ssGetDataTypeId(S, "uint32"));
+  }
    
   ssSupportsMultipleExecInstances(S, true); 
 
@@ -280,6 +381,22 @@ static void mdlSetWorkWidths(SimStruct *S)
 
 #endif
 
+#define MDL_INITIALIZE_CONDITIONS
+#if defined(MDL_INITIALIZE_CONDITIONS)
+
+/* Function: mdlInitializeConditions ======================================
+ * Abstract:
+ *    Start again from the first row of the timestamp table.
+ */
+static void mdlInitializeConditions(SimStruct *S)
+{
+  if (USE_TIMESTAMPS(S)) {
+    *(uint32_T *) ssGetDWork(S, 0) = 0;
+  }
+}
+
+#endif
+
 /* Function: mdlOutputs ===================================================
  * Abstract:
  *    In this function, you compute the outputs of your S-function
@@ -292,13 +409,42 @@ static void mdlOutputs(SimStruct *S, int_T tid)
    * Get access to Parameter/Input/Output/DWork/size information
    */
   real_T *p1 = (real_T *) ssGetRunTimeParamInfo(S, 0)->data;
-  real_T *y1 = (real_T *) ssGetOutputPortSignal(S, 0);
   int_T  sti = ssGetOutputPortSampleTimeIndex(S,0);
+  real_T t;
   /*
    * Get simultion time and add the offset (epoch) parameter to it.
    */
   if(ssIsSampleHit(S,sti,tid)) { 
-     *y1 = ssGetTaskTime(S,sti) + (real_T)(*p1); 
+     if (USE_TIMESTAMPS(S)) {
+       /* 
+        * Next row of the timestamp table (column major, Nx2).  The 
+        * last row is held once the table is exhausted.
+        */
+       const ssParamRec *ts  = ssGetRunTimeParamInfo(S, 3);
+       const uint32_T   *tab = (const uint32_T *) ts->data;
+       uint32_T          n   = (uint32_T) ts->dimensions[0];
+       uint32_T         *idx = (uint32_T *) ssGetDWork(S, 0);
+       uint32_T          row = (*idx < n) ? *idx : n-1;
+       if (*idx < n) (*idx)++;
+       if (OUTPUT_MODE_VAL == OUTPUT_SEC_SUBSEC) {
+         uint32_T *y1 = (uint32_T *) ssGetOutputPortSignal(S, 0);
+         y1[0] = tab[row];
+         y1[1] = tab[row+n];
+       } else {
+         real_T *y1 = (real_T *) ssGetOutputPortSignal(S, 0);
+         *y1 = (real_T)tab[row] + ((real_T)tab[row+n] * 2.3283064365386962890625E-10);
+       }
+       return;
+     }
+     t = ssGetTaskTime(S,sti) + (real_T)(*p1); 
+     if (OUTPUT_MODE_VAL == OUTPUT_SEC_SUBSEC) {
+       uint32_T *y1 = (uint32_T *) ssGetOutputPortSignal(S, 0);
+       y1[0] = (uint32_T)floor(t);
+       y1[1] = (uint32_T)((t - floor(t)) * 4294967296.0);
+     } else {
+       real_T *y1 = (real_T *) ssGetOutputPortSignal(S, 0);
+       *y1 = t;
+     }
   }
 }
 
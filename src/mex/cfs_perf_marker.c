@@ -0,0 +1,155 @@
+/**
+ * cfs_perf_marker.c
+ *
+ *    ABSTRACT:
+ *      This S-function implements the SIL Perf Marker block.
+ *
+ *      Placed in an atomic subsystem, the block TLC brackets the output
+ *      code of the subsystem with ECI_PERF_ENTRY and ECI_PERF_EXIT of a
+ *      perf ID allocated in <model>_perfids.h, so the subsystem shows as
+ *      its own block in the cFE performance log.  The block does nothing
+ *      in simulation.
+ *
+ */
+
+/* Must specify the S_FUNCTION_NAME as the name of the S-function */
+#define S_FUNCTION_NAME  cfs_perf_marker
+#define S_FUNCTION_LEVEL 2
+
+/**
+ * Need to include simstruc.h for the definition of the SimStruct and
+ * its associated macro definitions.
+ */
+#include "simstruc.h"
+
+/* Marker name Parm */
+#define NAME_IDX        0
+#define NAME(S)         (ssGetSFcnParam(S,NAME_IDX))
+
+#define NPARAMS 1
+
+#define MDL_CHECK_PARAMETERS
+#if defined(MDL_CHECK_PARAMETERS) && defined(MATLAB_MEX_FILE)
+
+/* Function: mdlCheckParameters ===========================================
+ * Abstract:
+ *   mdlCheckParameters verifies new parameter settings whenever parameter
+ *   change or are re-evaluated during a simulation. When a simulation is
+ *   running, changes to S-function parameters can occur at any time during
+ *   the simulation loop.
+ */
+static void mdlCheckParameters(SimStruct *S)
+{
+    /* Check the parameter 1: Marker name, used in the perf ID macro */
+    if (!mxIsChar(NAME(S)) || mxIsEmpty(NAME(S))) {
+        ssSetErrorStatus(S,"Perf Marker name must be a non-empty string");
+        return;
+    }
+}
+#endif
+
+/* Function: mdlInitializeSizes ===========================================
+ * Abstract:
+ *   The sizes information is used by Simulink to determine the S-function
+ *   block's characteristics (number of inputs, outputs, states, etc.).
+ */
+static void mdlInitializeSizes(SimStruct *S)
+{
+    /* Number of expected parameters */
+    ssSetNumSFcnParams(S, NPARAMS);
+
+    #if defined(MATLAB_MEX_FILE) 
+    if (ssGetNumSFcnParams(S) == ssGetSFcnParamsCount(S)) {
+        mdlCheckParameters(S);
+        if (ssGetErrorStatus(S) != NULL) return;
+    } else {
+        /* Return if number of expected != number of actual parameters */
+        return;
+    } /* if */
+    #endif 
+
+    ssSetSFcnParamTunable(S, NAME_IDX, 0);
+
+    if (!ssSetNumDWork(S, 0)) return;
+    if (!ssSetNumInputPorts(S, 0)) return;
+    if (!ssSetNumOutputPorts(S, 0)) return;
+
+    /* This S-function can be used in referenced model simulating in normal mode */
+    ssSetModelReferenceNormalModeSupport(S, MDL_START_AND_MDL_PROCESS_PARAMS_OK);
+
+    /* Set the number of sample time */
+    ssSetNumSampleTimes(S, 1);
+
+    /* Set the compliance with the SimState feature */
+    ssSetSimStateCompliance(S, USE_DEFAULT_SIM_STATE);
+
+    /* Set the Simulink version this S-Function has been generated in */
+    ssSetSimulinkVersionGeneratedIn(S, "9.0");
+
+    ssSetOptions(S,
+        SS_OPTION_USE_TLC_WITH_ACCELERATOR |
+        SS_OPTION_CAN_BE_CALLED_CONDITIONALLY |
+        SS_OPTION_EXCEPTION_FREE_CODE |
+        SS_OPTION_WORKS_WITH_CODE_REUSE |
+        SS_OPTION_SFUNCTION_INLINED_FOR_RTW |
+        SS_OPTION_DISALLOW_CONSTANT_SAMPLE_TIME
+    );
+}
+
+/* Function: mdlInitializeSampleTimes =====================================
+ * Abstract:
+ *   Inherits the rate of the subsystem the block is placed in.
+ */
+static void mdlInitializeSampleTimes(SimStruct *S)
+{
+    ssSetSampleTime(S, 0, INHERITED_SAMPLE_TIME);
+    ssSetOffsetTime(S, 0, FIXED_IN_MINOR_STEP_OFFSET);
+
+    #if defined(ssSetModelReferenceSampleTimeDefaultInheritance)
+    ssSetModelReferenceSampleTimeDefaultInheritance(S);
+    #endif
+}
+
+/* Function: mdlOutputs ===================================================
+ * Abstract:
+ *   No outputs; the markers are only generated in code.
+ */
+static void mdlOutputs(SimStruct *S, int_T tid)
+{
+}
+
+#define MDL_RTW
+#if defined(MDL_RTW) && defined(MATLAB_MEX_FILE)
+/* Function: mdlRTW =======================================================
+ * Abstract:
+ *   Writes the marker name for the block TLC.
+ */
+static void mdlRTW(SimStruct *S)
+{
+    char name[64];
+
+    if (mxGetString(NAME(S), name, sizeof(name)) != 0) {
+        ssSetErrorStatus(S,"Perf Marker name must be less than 64 characters");
+        return;
+    }
+    if (!ssWriteRTWParamSettings(S, 1, SSWRITE_VALUE_QSTR, "PerfName", name)) {
+        return;
+    }
+}
+#endif
+
+/* Function: mdlTerminate =================================================
+ * Abstract:
+ *   In this function, you should perform any actions that are necessary
+ *   at the termination of a simulation.
+ */
+static void mdlTerminate(SimStruct *S)
+{
+}
+
+/* Required S-function trailer */
+#ifdef    MATLAB_MEX_FILE
+# include "simulink.c"
+#else
+# include "cg_sfun.h"
+#endif
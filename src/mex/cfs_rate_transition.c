@@ -0,0 +1,364 @@
+/**
+ * cfs_rate_transition.c
+ *
+ *    ABSTRACT:
+ *      This S-function implements the SIL Rate Transition block.
+ *
+ *      Data written at the input (writer) rate is passed to the output
+ *      (reader) rate through a triple buffer.  The writer fills its own
+ *      buffer then exchanges it with the shared middle buffer; the reader
+ *      exchanges its buffer with the middle buffer only when new data has
+ *      been published.  Neither side blocks or waits for the other, so
+ *      the two rates may run as concurrent tasks on different cores (see
+ *      the ECI_Tasks table) without mutexes and without data tearing.
+ *
+ *      The block TLC generates the exchanges with the ECI_RT_XCHG and
+ *      ECI_RT_LOAD atomic macros (acquire/release ordering).
+ *
+ */
+
+/* Must specify the S_FUNCTION_NAME as the name of the S-function */
+#define S_FUNCTION_NAME  cfs_rate_transition
+#define S_FUNCTION_LEVEL 2
+
+/**
+ * Need to include simstruc.h for the definition of the SimStruct and
+ * its associated macro definitions.
+ */
+#include "simstruc.h"
+#include <string.h>
+
+#define INPUT_IDX       0
+#define OUTPUT_IDX      0
+
+/* Initial value Parm */
+#define IC_IDX          0
+#define IC(S)           (ssGetSFcnParam(S,IC_IDX))
+#define IC_VAL(S)       (mxGetScalar(ssGetSFcnParam(S,IC_IDX)))
+/* Output (reader) sample time Parm */
+#define TS_IDX          1
+#define TS(S)           (ssGetSFcnParam(S,TS_IDX))
+
+#define NPARAMS 2
+
+/* DWorks */
+#define BUF_DWORK       0   /* 3 buffers of the input width */
+#define MID_DWORK       1   /* shared middle buffer index | NEW_DATA */
+#define WIDX_DWORK      2   /* buffer owned by the writer */
+#define RIDX_DWORK      3   /* buffer owned by the reader */
+
+#define NUM_BUFS        3
+#define NEW_DATA        4U  /* set in the middle index when published */
+#define IDX_MASK        3U
+
+#define IS_REAL(pVal) (mxIsNumeric(pVal) && !mxIsLogical(pVal) &&\
+!mxIsEmpty(pVal) && !mxIsSparse(pVal) && !mxIsComplex(pVal) && mxIsDouble(pVal))
+
+#define MDL_CHECK_PARAMETERS
+#if defined(MDL_CHECK_PARAMETERS) && defined(MATLAB_MEX_FILE)
+
+/* Function: mdlCheckParameters ===========================================
+ * Abstract:
+ *   mdlCheckParameters verifies new parameter settings whenever parameter
+ *   change or are re-evaluated during a simulation. When a simulation is
+ *   running, changes to S-function parameters can occur at any time during
+ *   the simulation loop.
+ */
+static void mdlCheckParameters(SimStruct *S)
+{
+    if ((ssGetSimMode(S)==SS_SIMMODE_SIZES_CALL_ONLY)) {
+        return;
+    }
+
+    /* Check the parameter 1: Initial value */
+    if (!IS_REAL(IC(S)) || mxGetNumberOfElements(IC(S)) != 1) {
+        ssSetErrorStatus(S,"Rate Transition initial value must be a real scalar");
+        return;
+    }
+
+    /* Check the parameter 2: Output sample time */
+    if (!IS_REAL(TS(S)) || mxGetNumberOfElements(TS(S)) != 1 ||
+        mxGetScalar(TS(S)) <= 0.0) {
+        ssSetErrorStatus(S,"Rate Transition output sample time must be a positive discrete period");
+        return;
+    }
+}
+#endif
+
+/* Function: mdlInitializeSizes ===========================================
+ * Abstract:
+ *   The sizes information is used by Simulink to determine the S-function
+ *   block's characteristics (number of inputs, outputs, states, etc.).
+ */
+static void mdlInitializeSizes(SimStruct *S)
+{
+    /* Number of expected parameters */
+    ssSetNumSFcnParams(S, NPARAMS);
+
+    #if defined(MATLAB_MEX_FILE)
+    if (ssGetNumSFcnParams(S) == ssGetSFcnParamsCount(S)) {
+        /**
+         * If the number of expected input parameters is not equal
+         * to the number of parameters entered in the dialog box return.
+         * Simulink will generate an error indicating that there is a
+         * parameter mismatch.
+         */
+        mdlCheckParameters(S);
+        if (ssGetErrorStatus(S) != NULL) return;
+    } else {
+        /* Return if number of expected != number of actual parameters */
+        return;
+    } /* if */
+    #endif
+
+    /* Set the parameter's tunability */
+    ssSetSFcnParamTunable(S, IC_IDX, 0);
+    ssSetSFcnParamTunable(S, TS_IDX, 0);
+
+    /* Set the number of input ports */
+    if (!ssSetNumInputPorts(S,1)) return;
+
+    /* Data input: written at the (inherited) input rate */
+    ssSetInputPortDataType(S, INPUT_IDX, DYNAMICALLY_TYPED);
+    ssSetInputPortWidth(S, INPUT_IDX, DYNAMICALLY_SIZED);
+    ssSetInputPortComplexSignal(S, INPUT_IDX, COMPLEX_NO);
+    ssSetInputPortDirectFeedThrough(S, INPUT_IDX, 0);
+    ssSetInputPortRequiredContiguous(S, INPUT_IDX, 1);
+    ssSetInputPortSampleTime(S, INPUT_IDX, INHERITED_SAMPLE_TIME);
+    ssSetInputPortOffsetTime(S, INPUT_IDX, 0.0);
+
+    /* Set the number of output ports */
+    if (!ssSetNumOutputPorts(S, 1)) return;
+
+    /* Data output: read at the output rate */
+    ssSetOutputPortDataType(S, OUTPUT_IDX, DYNAMICALLY_TYPED);
+    ssSetOutputPortWidth(S, OUTPUT_IDX, DYNAMICALLY_SIZED);
+    ssSetOutputPortComplexSignal(S, OUTPUT_IDX, COMPLEX_NO);
+    ssSetOutputPortSampleTime(S, OUTPUT_IDX, mxGetScalar(TS(S)));
+    ssSetOutputPortOffsetTime(S, OUTPUT_IDX, 0.0);
+    ssSetOutputPortOptimOpts(S, OUTPUT_IDX, SS_NOT_REUSABLE_AND_GLOBAL);
+
+    /* Buffers and indices (sized in mdlSetWorkWidths) */
+    if (!ssSetNumDWork(S, 4)) return;
+    ssSetDWorkName(S, BUF_DWORK, "rtBuf");
+    ssSetDWorkName(S, MID_DWORK, "rtMid");
+    ssSetDWorkDataType(S, MID_DWORK, SS_UINT32);
+    ssSetDWorkWidth(S, MID_DWORK, 1);
+    ssSetDWorkName(S, WIDX_DWORK, "rtWIdx");
+    ssSetDWorkDataType(S, WIDX_DWORK, SS_UINT32);
+    ssSetDWorkWidth(S, WIDX_DWORK, 1);
+    ssSetDWorkName(S, RIDX_DWORK, "rtRIdx");
+    ssSetDWorkDataType(S, RIDX_DWORK, SS_UINT32);
+    ssSetDWorkWidth(S, RIDX_DWORK, 1);
+
+    /* Port based sample times: writer rate in, reader rate out */
+    ssSetNumSampleTimes(S, PORT_BASED_SAMPLE_TIMES);
+
+    ssSetOptions(S, SS_OPTION_PORT_SAMPLE_TIMES_ASSIGNED |
+                    SS_OPTION_WORKS_WITH_CODE_REUSE |
+                    SS_OPTION_EXCEPTION_FREE_CODE |
+                    SS_OPTION_SFUNCTION_INLINED_FOR_RTW |
+                    SS_OPTION_DISALLOW_CONSTANT_SAMPLE_TIME);
+}
+
+/* Function: mdlInitializeSampleTimes =====================================
+ * Abstract:
+ *   Sample times are port based (see mdlInitializeSizes).
+ */
+static void mdlInitializeSampleTimes(SimStruct *S)
+{
+#if defined(ssSetModelReferenceSampleTimeDefaultInheritance)
+    ssSetModelReferenceSampleTimeDefaultInheritance(S);
+#endif
+}
+
+#define MDL_SET_INPUT_PORT_SAMPLE_TIME
+#if defined(MDL_SET_INPUT_PORT_SAMPLE_TIME) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetInputPortSampleTime ====================================
+ * Abstract:
+ *   The writer rate is inherited from the input signal and must be
+ *   discrete.
+ */
+static void mdlSetInputPortSampleTime(SimStruct *S,
+                                      int_T     portIdx,
+                                      real_T    sampleTime,
+                                      real_T    offsetTime)
+{
+    if (sampleTime <= 0.0) {
+        ssSetErrorStatus(S,"Rate Transition input must have a discrete sample time");
+        return;
+    }
+    ssSetInputPortSampleTime(S, portIdx, sampleTime);
+    ssSetInputPortOffsetTime(S, portIdx, offsetTime);
+}
+#endif
+
+#define MDL_SET_OUTPUT_PORT_SAMPLE_TIME
+#if defined(MDL_SET_OUTPUT_PORT_SAMPLE_TIME) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetOutputPortSampleTime ===================================
+ * Abstract:
+ *   The reader rate is set by the block parameter and is not inherited.
+ */
+static void mdlSetOutputPortSampleTime(SimStruct *S,
+                                       int_T     portIdx,
+                                       real_T    sampleTime,
+                                       real_T    offsetTime)
+{
+    ssSetErrorStatus(S,"Rate Transition output sample time is set by the block parameter");
+}
+#endif
+
+#define MDL_SET_INPUT_PORT_DATA_TYPE
+#if defined(MDL_SET_INPUT_PORT_DATA_TYPE) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetInputPortDataType ======================================
+ * Abstract:
+ *   The output and the buffers have the input data type.
+ */
+static void mdlSetInputPortDataType(SimStruct *S, int portIndex, DTypeId dType)
+{
+    ssSetInputPortDataType(S, portIndex, dType);
+    ssSetOutputPortDataType(S, OUTPUT_IDX, dType);
+}
+#endif
+
+#define MDL_SET_OUTPUT_PORT_DATA_TYPE
+#if defined(MDL_SET_OUTPUT_PORT_DATA_TYPE) && defined(MATLAB_MEX_FILE)
+static void mdlSetOutputPortDataType(SimStruct *S, int portIndex, DTypeId dType)
+{
+    ssSetOutputPortDataType(S, portIndex, dType);
+    ssSetInputPortDataType(S, INPUT_IDX, dType);
+}
+#endif
+
+#define MDL_SET_DEFAULT_PORT_DATA_TYPES
+#if defined(MDL_SET_DEFAULT_PORT_DATA_TYPES) && defined(MATLAB_MEX_FILE)
+static void mdlSetDefaultPortDataTypes(SimStruct *S)
+{
+    ssSetInputPortDataType(S, INPUT_IDX, SS_DOUBLE);
+    ssSetOutputPortDataType(S, OUTPUT_IDX, SS_DOUBLE);
+}
+#endif
+
+#define MDL_SET_WORK_WIDTHS
+#if defined(MDL_SET_WORK_WIDTHS) && defined(MATLAB_MEX_FILE)
+/* Function: mdlSetWorkWidths =============================================
+ * Abstract:
+ *   Size the buffers from the input width and type, and register the
+ *   initial value for the block TLC.
+ */
+static void mdlSetWorkWidths(SimStruct *S)
+{
+    ssSetDWorkDataType(S, BUF_DWORK, ssGetInputPortDataType(S, INPUT_IDX));
+    ssSetDWorkWidth(S, BUF_DWORK, NUM_BUFS * ssGetInputPortWidth(S, INPUT_IDX));
+
+    if (!ssSetNumRunTimeParams(S, 1)) return;
+    ssRegDlgParamAsRunTimeParam(S, IC_IDX, 0, "rt_ic", ssGetDataTypeId(S, "double"));
+}
+#endif
+
+/* Function: cfsRtIcFill ==================================================
+ * Abstract:
+ *   Sets n elements of the given type to the initial value.
+ */
+static void cfsRtIcFill(SimStruct *S, void *dst, int_T n)
+{
+    DTypeId dt  = ssGetInputPortDataType(S, INPUT_IDX);
+    real_T  ic  = IC_VAL(S);
+    int_T   i;
+
+    for (i = 0; i < n; i++) {
+        switch (dt) {
+          case SS_DOUBLE:  ((real_T *)dst)[i]    = ic;              break;
+          case SS_SINGLE:  ((real32_T *)dst)[i]  = (real32_T)ic;    break;
+          case SS_INT8:    ((int8_T *)dst)[i]    = (int8_T)ic;      break;
+          case SS_UINT8:   ((uint8_T *)dst)[i]   = (uint8_T)ic;     break;
+          case SS_INT16:   ((int16_T *)dst)[i]   = (int16_T)ic;     break;
+          case SS_UINT16:  ((uint16_T *)dst)[i]  = (uint16_T)ic;    break;
+          case SS_INT32:   ((int32_T *)dst)[i]   = (int32_T)ic;     break;
+          case SS_UINT32:  ((uint32_T *)dst)[i]  = (uint32_T)ic;    break;
+          case SS_BOOLEAN: ((boolean_T *)dst)[i] = (ic != 0.0);     break;
+          default:         break;
+        }
+    }
+}
+
+#define MDL_INITIALIZE_CONDITIONS
+#if defined(MDL_INITIALIZE_CONDITIONS)
+/* Function: mdlInitializeConditions ======================================
+ * Abstract:
+ *   All buffers and the output start at the initial value.  The writer
+ *   owns buffer 0, the middle is buffer 1 and the reader owns buffer 2.
+ */
+static void mdlInitializeConditions(SimStruct *S)
+{
+    int_T width = ssGetInputPortWidth(S, INPUT_IDX);
+
+    cfsRtIcFill(S, ssGetDWork(S, BUF_DWORK), NUM_BUFS * width);
+    cfsRtIcFill(S, ssGetOutputPortSignal(S, OUTPUT_IDX), width);
+    *(uint32_T *)ssGetDWork(S, WIDX_DWORK) = 0;
+    *(uint32_T *)ssGetDWork(S, MID_DWORK)  = 1;
+    *(uint32_T *)ssGetDWork(S, RIDX_DWORK) = 2;
+}
+#endif
+
+/* Function: mdlOutputs ===================================================
+ * Abstract:
+ *   At a reader hit, take the newest published buffer (if any) and copy
+ *   it to the output.
+ */
+static void mdlOutputs(SimStruct *S, int_T tid)
+{
+    if (ssIsSampleHit(S, ssGetOutputPortSampleTimeIndex(S, OUTPUT_IDX), tid)) {
+        int_T     width = ssGetInputPortWidth(S, INPUT_IDX);
+        size_t    size  = width * ssGetDataTypeSize(S, ssGetInputPortDataType(S, INPUT_IDX));
+        char     *buf   = (char *)ssGetDWork(S, BUF_DWORK);
+        uint32_T *mid   = (uint32_T *)ssGetDWork(S, MID_DWORK);
+        uint32_T *ridx  = (uint32_T *)ssGetDWork(S, RIDX_DWORK);
+
+        if (*mid & NEW_DATA) {
+            uint32_T tmp = *mid;
+            *mid  = *ridx;
+            *ridx = tmp & IDX_MASK;
+        }
+        (void)memcpy(ssGetOutputPortSignal(S, OUTPUT_IDX), &buf[*ridx * size], size);
+    }
+}
+
+#define MDL_UPDATE
+#if defined(MDL_UPDATE)
+/* Function: mdlUpdate ====================================================
+ * Abstract:
+ *   At a writer hit, fill the writer buffer and publish it as the middle
+ *   buffer.
+ */
+static void mdlUpdate(SimStruct *S, int_T tid)
+{
+    if (ssIsSampleHit(S, ssGetInputPortSampleTimeIndex(S, INPUT_IDX), tid)) {
+        int_T     width = ssGetInputPortWidth(S, INPUT_IDX);
+        size_t    size  = width * ssGetDataTypeSize(S, ssGetInputPortDataType(S, INPUT_IDX));
+        char     *buf   = (char *)ssGetDWork(S, BUF_DWORK);
+        uint32_T *mid   = (uint32_T *)ssGetDWork(S, MID_DWORK);
+        uint32_T *widx  = (uint32_T *)ssGetDWork(S, WIDX_DWORK);
+        uint32_T  tmp;
+
+        (void)memcpy(&buf[*widx * size], ssGetInputPortSignal(S, INPUT_IDX), size);
+        tmp   = *mid;
+        *mid  = *widx | NEW_DATA;
+        *widx = tmp & IDX_MASK;
+    }
+}
+#endif
+
+/* Function: mdlTerminate =================================================
+ * Abstract:
+ *   No termination needed, but we are required to have this routine.
+ */
+static void mdlTerminate(SimStruct *S)
+{
+}
+
+#ifdef  MATLAB_MEX_FILE    /* Is this file being compiled as a MEX-file? */
+#include "simulink.c"      /* MEX-file interface mechanism */
+#else
+#include "cg_sfun.h"       /* Code generation registration function */
+#endif
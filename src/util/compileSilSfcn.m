@@ -8,5 +8,7 @@ function compileSilSfcn()
     compileIfNeeded('cfs_event')
     compileIfNeeded('cfs_fdc')
     compileIfNeeded('cfs_gnc_time')
+    compileIfNeeded('cfs_perf_marker')
+    compileIfNeeded('cfs_rate_transition')
     
 end % compileAll()
\ No newline at end of file
@@ -0,0 +1,218 @@
+function bytes = createCfsTblImage(fileName, value, paramName, appName, varargin)
+% createCfsTblImage() Writes a cFE table image for a cfsParmTable parameter
+% directly from its value
+%
+% Builds the cFE file header, the cFE table header and the table data,
+% laid out as the flight compiler lays out the parameter's bus type
+% (members in bus order, each aligned to its size, the struct padded to
+% its largest member).  No C definition file or elf2cfetbl run is
+% needed, so table variants can be generated from MATLAB structs.
+%
+% usage:
+%   createCfsTblImage('gains.tbl', gainsStruct, 'gains', 'gnc')
+%   bytes = createCfsTblImage('', gainsStruct, 'gains', 'gnc', 'Endian', 'big')
+%
+%   fileName    image file to write, or '' to only return the bytes
+%   value       the struct given to createCfsTbl, or the parameter object
+%   paramName   parameter name.  Its bus, <paramName>_b (see createCfsTbl),
+%               is read from the base workspace unless Bus is given
+%   appName     model name; the table is named <appName>.<paramName>
+%
+% Options:
+%   Bus             Simulink.Bus object, or bus name, of the table type
+%   Endian          byte order of the table data, 'little' (default) or
+%                   'big'.  The cFE headers are always big endian.
+%   DoubleAlign     alignment of 64 bit members, 8 (default) or 4 (e.g.
+%                   i386 System V)
+%   ArrayLayout     element order of array members, 'Column-major'
+%                   (default) or 'Row-major', as the model's Array layout
+%                   setting
+%   Description     cFE file header description (default
+%                   '<appName> <paramName>', as in ECI_TBL_FILEDEF)
+%   SpacecraftID    cFE file header IDs (default 0)
+%   ProcessorID
+%   ApplicationID
+%   Time            [seconds subseconds] of the cFE file header
+%                   (default [0 0])
+%   TableNameLen    CFE_MISSION_TBL_MAX_FULL_NAME_LEN (default 40)
+%
+%   bytes           the image (uint8 column vector)
+%
+% Complex elements are not supported, as cFE tables hold no complex data.
+%
+
+    p = inputParser;
+    p.addParameter('Bus', [], @(x) ischar(x) || isa(x, 'Simulink.Bus'));
+    p.addParameter('Endian', 'little', @(x) any(strcmpi(x, {'little','big'})));
+    p.addParameter('DoubleAlign', 8, @(x) isscalar(x) && any(x == [4 8]));
+    p.addParameter('ArrayLayout', 'Column-major', ...
+                   @(x) any(strcmpi(x, {'Column-major','Row-major'})));
+    p.addParameter('Description', [appName ' ' paramName], @ischar);
+    p.addParameter('SpacecraftID', 0, @isscalar);
+    p.addParameter('ProcessorID', 0, @isscalar);
+    p.addParameter('ApplicationID', 0, @isscalar);
+    p.addParameter('Time', [0 0], @(x) numel(x) == 2);
+    p.addParameter('TableNameLen', 40, @(x) isscalar(x) && x > 0);
+    p.parse(varargin{:});
+    opts = p.Results;
+
+    [~, ~, hostEndian] = computer;
+    opts.swap = (hostEndian == 'L') ~= strcmpi(opts.Endian, 'little');
+    opts.rowMajor = strcmpi(opts.ArrayLayout, 'Row-major');
+
+    if isa(value, 'Simulink.Parameter')
+        value = value.Value;
+    end
+    if isempty(opts.Bus)
+        opts.Bus = [paramName '_b'];
+    end
+    bus = resolveBus(opts.Bus);
+
+    data = packBus(bus, value, opts);
+
+    tableName = [appName '.' paramName];
+    if numel(tableName) >= opts.TableNameLen
+        error('createCfsTblImage:nameTooLong', ...
+              'Table name %s must be less than %d characters', tableName, opts.TableNameLen);
+    end
+
+    % cFE file header (CFE_FS_Header_t), big endian
+    fsHdr = [ be32(hex2dec('63464531')) ; ...   % ContentType 'cFE1'
+              be32(8) ; ...                     % SubType: table image
+              be32(64) ; ...                    % Length of this header
+              be32(opts.SpacecraftID) ; ...
+              be32(opts.ProcessorID) ; ...
+              be32(opts.ApplicationID) ; ...
+              be32(opts.Time(1)) ; ...
+              be32(opts.Time(2)) ; ...
+              padStr(opts.Description, 32) ];
+
+    % cFE table header (CFE_TBL_File_Hdr_t), big endian
+    tblHdr = [ be32(0) ; ...                    % Reserved
+               be32(0) ; ...                    % Offset
+               be32(numel(data)) ; ...          % NumBytes
+               padStr(tableName, opts.TableNameLen) ];
+
+    bytes = [fsHdr ; tblHdr ; data];
+
+    if ~isempty(fileName)
+        fid = fopen(fileName, 'w');
+        if fid < 0
+            error('createCfsTblImage:openFailed', 'Could not create %s', fileName);
+        end
+        fwrite(fid, bytes, 'uint8');
+        fclose(fid);
+    end
+end
+
+function [data, align] = packBus(bus, value, opts)
+% Packs one struct of a bus type, returning its bytes (padded to its
+% alignment) and its alignment
+
+    data  = zeros(0, 1, 'uint8');
+    align = 1;
+    for k = 1:numel(bus.Elements)
+        el = bus.Elements(k);
+        if ~isfield(value, el.Name)
+            error('createCfsTblImage:missingField', ...
+                  'Value has no field %s of the bus', el.Name);
+        end
+        v  = value.(el.Name);
+        n  = prod(el.Dimensions);
+        dt = strtrim(el.DataType);
+        if numel(v) ~= n
+            error('createCfsTblImage:badSize', ...
+                  'Field %s has %d elements, the bus %d', el.Name, numel(v), n);
+        end
+        if strcmpi(el.Complexity, 'complex') || (isnumeric(v) && ~isreal(v))
+            error('createCfsTblImage:complex', ...
+                  'Element %s is complex, which is not supported', el.Name);
+        end
+        order = elementOrder(el.Dimensions, opts);
+
+        if strncmp(dt, 'Bus:', 4)
+            sub = resolveBus(strtrim(dt(5:end)));
+            elBytes = zeros(0, 1, 'uint8');
+            for i = order'
+                [b, a] = packBus(sub, v(i), opts);
+                elBytes = [elBytes ; b]; %#ok<AGROW>
+            end
+        else
+            [cls, sz] = typeInfo(dt, el.Name);
+            a = sz;
+            if sz == 8
+                a = opts.DoubleAlign;
+            end
+            % in the generated code's array layout
+            elBytes = typecast(cast(v(order), cls), 'uint8');
+            if opts.swap && sz > 1
+                elBytes = reshape(flipud(reshape(elBytes, sz, [])), [], 1);
+            end
+            elBytes = elBytes(:);
+        end
+
+        data  = [data ; zeros(padLen(numel(data), a), 1, 'uint8') ; elBytes]; %#ok<AGROW>
+        align = max(align, a);
+    end
+    data = [data ; zeros(padLen(numel(data), align), 1, 'uint8')];
+end
+
+function [cls, sz] = typeInfo(dt, name)
+% MATLAB class and size of a bus element data type
+    switch dt
+        case {'double', 'int64', 'uint64'}
+            cls = dt; sz = 8;
+        case {'single', 'int32', 'uint32'}
+            cls = dt; sz = 4;
+        case {'int16', 'uint16'}
+            cls = dt; sz = 2;
+        case {'int8', 'uint8'}
+            cls = dt; sz = 1;
+        case 'boolean'
+            cls = 'uint8'; sz = 1;
+        otherwise
+            if strncmp(dt, 'Enum:', 5)
+                cls = 'int32'; sz = 4;
+            else
+                error('createCfsTblImage:badType', ...
+                      'Element %s has unsupported data type %s', name, dt);
+            end
+    end
+end
+
+function order = elementOrder(dims, opts)
+% Linear indices of an array member's elements in memory order
+    if isscalar(dims)
+        dims = [dims 1];
+    end
+    order = reshape(1:prod(dims), dims);
+    if opts.rowMajor
+        order = permute(order, numel(dims):-1:1);
+    end
+    order = order(:);
+end
+
+function bus = resolveBus(bus)
+    if ischar(bus)
+        bus = evalin('base', bus);
+    end
+end
+
+function n = padLen(offset, align)
+    n = mod(align - mod(offset, align), align);
+end
+
+function b = be32(x)
+    b = typecast(uint32(x), 'uint8');
+    [~, ~, hostEndian] = computer;
+    if hostEndian == 'L'
+        b = flipud(b(:));
+    end
+    b = b(:);
+end
+
+function b = padStr(s, len)
+    b = zeros(len, 1, 'uint8');
+    s = uint8(s(1:min(numel(s), len - 1)));
+    b(1:numel(s)) = s(:);
+end
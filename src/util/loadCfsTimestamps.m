@@ -0,0 +1,77 @@
+function tstamps = loadCfsTimestamps(source)
+% loadCfsTimestamps() Returns an Nx2 uint32 matrix of CFE timestamps
+%
+% The returned matrix is used as the Timestamps parameter of the CFS Time
+% block when its Time Source is set to 'Timestamp table'.  Each row is one
+% block execution: [seconds subseconds] with subseconds LSB = 2^-32 seconds,
+% the same as ECI_Step_TimeStamp.  This lets normal, accelerator and rapid
+% accelerator simulations reproduce the time quantization of flight code.
+%
+% The source may be:
+%   - an Nx2 numeric matrix of [seconds subseconds]
+%   - an N element vector of times in seconds (converted to the nearest
+%     subsecond count)
+%   - the name of a .mat file holding one such variable
+%   - the name of a text file (.csv, .txt) holding one such array, one
+%     row per step, numbers only (no header line)
+%
+% Since the Timestamps parameter is tunable, a rapid accelerator model can
+% be run against different timestamp tables (of the same length) without
+% rebuilding.
+%
+% usage:
+%   tstamps = loadCfsTimestamps('gnc_steps.csv')
+%   tstamps = loadCfsTimestamps(0:0.01:100)
+%
+
+    if ischar(source) || isstring(source)
+        source = char(source);
+        [~, ~, ext] = fileparts(source);
+        if strcmpi(ext, '.mat')
+            vars = struct2cell(load(source));
+            if numel(vars) ~= 1
+                error('loadCfsTimestamps:badFile', ...
+                      '%s must contain exactly one variable', source);
+            end
+            data = vars{1};
+        else
+            % dlmread rather than readmatrix (R2019a), for 2017b
+            data = dlmread(source);
+        end
+    else
+        data = source;
+    end
+
+    if isempty(data) || ~isnumeric(data)
+        error('loadCfsTimestamps:badData', ...
+              'Timestamps must be a non-empty numeric array');
+    end
+
+    if isvector(data) && size(data,2) ~= 2
+        % times in seconds
+        t = double(data(:));
+        if any(t < 0)
+            error('loadCfsTimestamps:badData', ...
+                  'Timestamps must not be negative');
+        end
+        secs    = floor(t);
+        subsecs = round((t - secs) * 2^32);
+        % rounding may carry into the next second
+        carry          = subsecs >= 2^32;
+        secs(carry)    = secs(carry) + 1;
+        subsecs(carry) = 0;
+        data = [secs subsecs];
+    elseif size(data,2) ~= 2
+        error('loadCfsTimestamps:badData', ...
+              'Timestamps must be Nx2 [seconds subseconds] or a vector of seconds');
+    end
+
+    if any(data(:) < 0) || any(data(:) > intmax('uint32')) || ...
+       any(data(:) ~= floor(data(:)))
+        error('loadCfsTimestamps:badData', ...
+              'Seconds and subseconds must be integers in the uint32 range');
+    end
+
+    tstamps = uint32(data);
+
+end % loadCfsTimestamps()
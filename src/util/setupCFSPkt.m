@@ -13,7 +13,10 @@ function pkt = setupCFSPkt(type)
 %
 % Note that the signal object generated here (either 'Cmd' or 'Tlm') be
 % used with a bus with the proper header specified for the packet to be
-% properly handled.
+% properly handled.  With the 'Manage CCSDS headers' option of the cFS
+% target, the header (first element of the bus, laid out as 
+% CCSDS_TlmHdr_b or CCSDS_CmdHdr_b) of sent packets is filled in by the
+% generated code and need not be built in the model.
 %
     
     pkt = cfsPackage.Signal();
@@ -0,0 +1,68 @@
+function members = unpackCfsTlmAggregate(pkt, varargin)
+% unpackCfsTlmAggregate() Splits an aggregate telemetry packet into its
+% member message payloads
+%
+% Aggregate packets are generated for cfsTlmMessage signals that share the
+% same Aggregate attribute.  The packet holds the telemetry header, a
+% member count, a directory of {MID, offset, size, spare} (uint16 each)
+% and the member payloads, so it can be unpacked without the model.
+%
+% usage:
+%   members = unpackCfsTlmAggregate(pkt)
+%   members = unpackCfsTlmAggregate(pkt, 'HeaderSize', 12, 'Endian', 'little')
+%
+%   pkt         uint8 vector holding one aggregate packet (as received)
+%   HeaderSize  telemetry header size in bytes (ECI_TLM_HDR_SIZE,
+%               default 12)
+%   Endian      byte order of the flight processor, 'little' (default)
+%               or 'big'
+%
+%   members     struct array with fields mid and payload (uint8 column
+%               vector, the member message without its header)
+%
+
+    p = inputParser;
+    p.addParameter('HeaderSize', 12, @(x) isscalar(x) && x >= 0);
+    p.addParameter('Endian', 'little', @(x) any(strcmpi(x, {'little','big'})));
+    p.parse(varargin{:});
+    hdrSize = p.Results.HeaderSize;
+    bigEndian = strcmpi(p.Results.Endian, 'big');
+
+    pkt = uint8(pkt(:));
+    if numel(pkt) < hdrSize + 4
+        error('unpackCfsTlmAggregate:badPacket', ...
+              'Packet is shorter than the aggregate header');
+    end
+
+    count = readU16(pkt, hdrSize);
+    dirStart = hdrSize + 4;
+    if numel(pkt) < dirStart + 8*count
+        error('unpackCfsTlmAggregate:badPacket', ...
+              'Packet is shorter than its directory (%d members)', count);
+    end
+
+    members = struct('mid', cell(count,1), 'payload', cell(count,1));
+    for i = 1:count
+        entry  = dirStart + 8*(i-1);
+        mid    = readU16(pkt, entry);
+        offset = readU16(pkt, entry + 2);
+        len    = readU16(pkt, entry + 4);
+        if double(offset) + double(len) > numel(pkt)
+            error('unpackCfsTlmAggregate:badPacket', ...
+                  'Member 0x%04X extends past the end of the packet', mid);
+        end
+        members(i).mid     = mid;
+        members(i).payload = pkt(double(offset) + (1:double(len)));
+    end
+
+    function v = readU16(bytes, offset)
+        % offset is zero based, as in the directory
+        b = double(bytes(offset + (1:2)));
+        if bigEndian
+            v = uint16(b(1)*256 + b(2));
+        else
+            v = uint16(b(2)*256 + b(1));
+        end
+    end
+
+end % unpackCfsTlmAggregate()
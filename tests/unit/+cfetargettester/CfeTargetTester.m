@@ -212,8 +212,56 @@ classdef CfeTargetTester < matlab.unittest.TestCase
                 end              
             end % end for         
         end % end checkCodeContents
-      
+        
+        % Sets custom attributes of the signal object of signal 'name' 
+        % for one test, restoring them on teardown.  The object is the 
+        % one embedded on the signal's source port, else the one in the 
+        % model workspace or data dictionary.
+        %
+        % usage:
+        %   testcase.setSignalAttributes(mdl, 'abc1', 'Alignment', '32')
+        function setSignalAttributes(testcase, model, name, varargin)
+            ph = find_system(model, 'FindAll', 'on', 'Type', 'port', ...
+                             'PortType', 'outport', 'Name', name);
+            if ~isempty(ph) && ~isempty(get_param(ph(1), 'SignalObject'))
+                ph  = ph(1);
+                sig = get_param(ph, 'SignalObject');
+            else
+                ph  = [];
+                sig = Simulink.data.evalinGlobal(model, name);
+            end
+            attrs = varargin(1:2:end);
+            prev  = cellfun(@(a) get(sig.CoderInfo.CustomAttributes, a), ...
+                            attrs, 'UniformOutput', false);
+            prev  = reshape([attrs ; prev], 1, []);
+            testcase.addTeardown(@() applySignalAttributes(ph, sig, prev));
+            applySignalAttributes(ph, sig, varargin);
+        end
+        
+        % Adds a terminated root Inport whose signal 'name' has 
+        % ExportedGlobal storage, for one test (e.g. the count input of 
+        % a batched message)
+        function addExportedInport(testcase, model, name, dataType, dims)
+            blk = [model '/' name];
+            add_block('simulink/Sources/In1', blk, ...
+                      'OutDataTypeStr', dataType, 'PortDimensions', dims);
+            add_block('simulink/Sinks/Terminator', [blk '_term']);
+            testcase.addTeardown(@() delete_block({blk, [blk '_term']}));
+            lh = add_line(model, [name '/1'], [name '_term/1']);
+            testcase.addTeardown(@() delete_line(lh));
+            ph = get_param(blk, 'PortHandles');
+            set_param(ph.Outport, 'Name', name, 'StorageClass', 'ExportedGlobal');
+        end
         
     end %methods
     
 end
+
+function applySignalAttributes(ph, sig, attrs)
+% Sets the custom attributes, and the object back on its port when it is
+% embedded there
+    set(sig.CoderInfo.CustomAttributes, attrs{:});
+    if ~isempty(ph)
+        set_param(ph, 'SignalObject', sig);
+    end
+end
@@ -3,6 +3,8 @@
 % Model: CDSBasic
 % Tests:
 %   - Generation of CDS Table
+%   - Warm start snapshot table
+%   - Warm start is rejected for a model that uses absolute time
 %
 
 classdef Test_CDSBasic < cfetargettester.CfeTargetTester
@@ -68,5 +70,50 @@ classdef Test_CDSBasic < cfetargettester.CfeTargetTester
             testcase.checkCodeContents(patterns);
         end        
 
+        % Check the warm start snapshot table and entry point
+        function testWarmStart(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_WARM_START__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_WARM_START__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                'static const ECI_Cds_t ECI_CdsTable[] = {', ...
+                '#define ECI_WARM_START_DEFINED 1', ...
+                'static const ECI_Cds_t ECI_WarmTable[] = {', ...
+                '{ "WARM_HDR", sizeof(ECI_WarmHdr), &ECI_WarmHdr },', ...
+                '{ NULL, 0, NULL }', ...
+                '#define ECI_WARM_PACK_FCN', ...
+                'static int ECI_WarmInit(void)', ...
+                'ECI_WARM_PACK_FCN', ...
+                'return 1;', ...
+                'ECI_INIT_FCN', ...
+                'return 0;', ...
+                '#define ECI_WARM_INIT_FCN ECI_WarmInit()' };
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % Check that warm start is rejected when the model uses absolute
+        % time, which is in the RT model and not in the snapshot
+        function testWarmStartAbsTimeFail(testcase)  
+            import matlab.unittest.constraints.Throws
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_WARM_START__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_WARM_START__', 'off'));
+            clk  = add_block('simulink/Sources/Digital Clock', [mdl '/WarmClock']);
+            term = add_block('simulink/Sinks/Terminator', [mdl '/WarmClockTerm']);
+            line = add_line(mdl, 'WarmClock/1', 'WarmClockTerm/1');
+            testcase.addTeardown(@() delete_block([clk term]));
+            testcase.addTeardown(@() delete_line(line));
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
     end
 end
@@ -3,6 +3,11 @@
 % Model: CmdMessageSingle
 % Tests:
 %   - Check for a single Cmd message entry in Send and Recieve table
+%   - Batch Count rejected on a scalar command input
+%   - Batch table of an array command input and its count input
+%   - Priority lane for a command input
+%   - Entry Function: ECI_MsgFcn table of an export-function model, and
+%     rejected names and non export-function models
 %
 
 classdef Test_CmdMessageSingle < cfetargettester.CfeTargetTester
@@ -61,5 +66,137 @@ classdef Test_CmdMessageSingle < cfetargettester.CfeTargetTester
             testcase.checkCodeContents(patterns);
         end        
 
+        % A Batch Count on a command input that is not an array of the
+        % command bus should fail the build
+        function testBatchCountScalarFail(testcase)  
+            import matlab.unittest.constraints.Throws
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'BatchCount', 'abc1_count');
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % A Batch Count on an array command input should generate the
+        % ECI_CmdBatch table without a command queue, and a count input 
+        % that is not uint32 should fail the build
+        function testBatchCount(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            mdl  = testcase.TestModel;
+            blk  = [mdl '/In1'];
+            dims = get_param(blk, 'PortDimensions');
+            set_param(blk, 'PortDimensions', '4');
+            testcase.addTeardown(@() set_param(blk, 'PortDimensions', dims));
+            testcase.addExportedInport(mdl, 'abc1_count', 'uint32', '1');
+            testcase.setSignalAttributes(mdl, 'abc1', 'BatchCount', 'abc1_count');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#include <string.h>', ...
+                '#define ECI_CMD_BATCH_DEFINED 1', ...
+                'static const ECI_CmdBatch_t ECI_CmdBatch[] = {', ...
+                '{ NESTEDBUS_ABC1_MID, &ECI_MsgRcv[0], 4, &abc1_count},', ...
+                '{0,NULL,0,NULL}', ...
+                'static int ECI_CmdBatchAdd(uint32_T mid, const void* msg, size_t size)', ...
+                'static void ECI_CmdBatchClear(void)' }   ;         
+            patterns(1).DoesNotContainStrings = {'abc1_queue'};
+            
+            testcase.checkCodeContents(patterns);
+            
+            set_param([mdl '/abc1_count'], 'OutDataTypeStr', 'double');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % A command with a Priority is queued in its lane instead of the
+        % app command queue, and an invalid Priority fails the build
+        function testPriorityLane(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'Priority', '5', 'LaneDepth', '4', 'DropPolicy', 'DropOldest');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsStrings = { '#include <string.h>' };
+            patterns(1).ContainsOrderedStrings = { ...           
+                '{ NESTEDBUS_ABC1_MID, &abc1, sizeof(NestedBus), NULL, NULL },' , ...
+                '#define ECI_CMD_LANES_DEFINED 1' , ...
+                '#define ECI_CMD_LANE_BUDGET 0U' , ...
+                'static ECI_CmdLane0_Slot_t ECI_CmdLane0_slots[4];' , ...
+                'static const ECI_CmdLane_t ECI_CmdLanes[] = {' , ...
+                '{ 5, ECI_CmdLane0_slots, sizeof(ECI_CmdLane0_Slot_t), ECI_CmdLane0_msgs, 4, 1,' , ...
+                '{ NESTEDBUS_ABC1_MID, &ECI_MsgRcv[0], &ECI_CmdLanes[0] },' , ...
+                'static int ECI_CmdLaneAdd(uint32_T mid, const void* msg, size_t size)' , ...
+                'static void ECI_CmdLaneService(void)' }   ;         
+            patterns(1).DoesNotContainStrings = {'abc1_queue'};
+            
+            testcase.checkCodeContents(patterns);
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'Priority', '300');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+
+        % An Entry Function must be a C identifier and is only accepted in
+        % an export-function model, where the ECI_MsgFcn table maps the
+        % command to it and ECI_STEP_FCN calls no model step
+        function testEntryFunction(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'EntryFunction', 'abc1 fcn');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+            
+            % CmdMessageSingle is not an export-function model
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'EntryFunction', 'abc1_fcn');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+            
+            % Export-function model running onCmd when cmd arrives
+            ph = find_system(testcase.TestModel, 'FindAll', 'on', 'Type', 'port', ...
+                             'PortType', 'outport', 'Name', 'abc1');
+            busType = get_param(get_param(ph(1), 'Parent'), 'OutDataTypeStr');
+            
+            mdl = 'CmdMsgFcnExport';
+            new_system(mdl);
+            testcase.addTeardown(@() close_system(mdl, 0));
+            cs = attachConfigSetCopy(mdl, getActiveConfigSet(testcase.TestModel), true);
+            setActiveConfigSet(mdl, cs.Name);
+            
+            add_block('simulink/Ports & Subsystems/In1', [mdl '/onCmd_call'], ...
+                      'OutputFunctionCall', 'on', 'SampleTime', '-1');
+            add_block('simulink/Ports & Subsystems/In1', [mdl '/cmd'], ...
+                      'OutDataTypeStr', busType);
+            add_block('simulink/Ports & Subsystems/Function-Call Subsystem', ...
+                      [mdl '/onCmd']);
+            add_block('simulink/Ports & Subsystems/Out1', [mdl '/out'], ...
+                      'OutDataTypeStr', busType);
+            add_line(mdl, 'onCmd_call/1', 'onCmd/Trigger');
+            add_line(mdl, 'cmd/1', 'onCmd/1');
+            add_line(mdl, 'onCmd/1', 'out/1');
+            
+            sig = setupCFSPkt('Cmd');
+            sig.CoderInfo.CustomAttributes.EntryFunction = 'onCmd_call';
+            ph = get_param([mdl '/cmd'], 'PortHandles');
+            set_param(ph.Outport, 'Name', 'cmd', 'SignalObject', sig);
+            
+            testcase.verifyThat(@() rtwbuild(mdl), IssuesNoWarnings);
+            
+            hdr = fileread(fullfile(testcase.workingFixture.Folder, ...
+                [mdl '_cfs_ert_rtw'], testcase.TestInterface));
+            msgFcn = ['{ ' upper(strrep(busType, 'Bus: ', '')) ...
+                      '_CMD_MID, &ECI_MsgRcv[0], onCmd_call},'];
+            testcase.verifySubstring(hdr, 'static const ECI_MsgFcn_t ECI_MsgFcn[] = {');
+            testcase.verifySubstring(hdr, msgFcn);
+            testcase.verifyEmpty(strfind(hdr, [mdl '_step']));
+        end        
     end
 end
@@ -4,6 +4,8 @@
 % Tests:
 %   - Conditional Msg blocks at top model level
 %   - Conditional Msg block in atomic (nonvirtual subsystem)
+%   - Zero copy and copy paths of the Conditional Msg block
+%   - Managed CCSDS headers are rejected with zero copy
 %
 
 classdef Test_ConditionalAtTop < cfetargettester.CfeTargetTester
@@ -55,8 +57,56 @@ classdef Test_ConditionalAtTop < cfetargettester.CfeTargetTester
                 '{ 0, NULL, 0, NULL, NULL }'  ,...
                 '};'    } ;            
             
+            % Copy path: the step copies the input bus into the message
+            patterns(2).FileName = [testcase.TestModel '.c'];
+            patterns(2).ContainsStrings = {'condMsg1 ='};
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % Check the zero copy path: the Send Table entry points at the 
+        % input bus and the step does not copy it into the message.
+        function testZeroCopy(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            blk = [mdl '/CFS_Conditional_Msg'];
+            set_param(blk, 'zero_copy', 'on');
+            testcase.addTeardown(@() set_param(blk, 'zero_copy', 'off'));
+            
+            % no warning, the input is a global the table can point at
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...                     
+                'static ECI_Msg_t ECI_MsgSnd[] = {'  ,...
+                '{ MSGBUS_CONDMSG1_MID, &'  ,...
+                '&cmsgFlag_ConditionalAtTop_233 },'  ,...
+                '{ MSGBUS_CONDMSG2_MID, &condMsg2, sizeof(msgBus), NULL,'  ,...
+                '&cmsgFlag_ConditionalAtTop_234 },'  } ;            
+            patterns(1).DoesNotContainStrings = { ...
+                '{ MSGBUS_CONDMSG1_MID, &condMsg1,' };
+            
+            patterns(2).FileName = [testcase.TestModel '.c'];
+            patterns(2).DoesNotContainStrings = {'condMsg1 ='};
+            
             testcase.checkCodeContents(patterns);
         end        
 
+        % Check that managed CCSDS headers are rejected with zero copy,
+        % the headers would be stamped into the block input bus.
+        function testManagedHdrsZeroCopyFail(testcase)  
+            import matlab.unittest.constraints.Throws
+            
+            mdl = testcase.TestModel;
+            blk = [mdl '/CFS_Conditional_Msg'];
+            set_param(blk, 'zero_copy', 'on');
+            testcase.addTeardown(@() set_param(blk, 'zero_copy', 'off'));
+            set_param(mdl, '__CFS_MANAGED_HDRS__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_MANAGED_HDRS__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
     end
 end
@@ -4,6 +4,7 @@
 % Tests:
 %   - Event blocks at top model level
 %   - Event block in atomic (nonvirtual subsystem)
+%   - Compact event table, with and without path IDs
 %
 
 classdef Test_EventAtTop < cfetargettester.CfeTargetTester
@@ -54,12 +55,14 @@ classdef Test_EventAtTop < cfetargettester.CfeTargetTester
                 '&EventAtTop_ConstP.pooled3,' , ...
                 '&EventAtTop_ConstP.pooled2,' , ...
                 '&evFlag_EventAtTop_222,' , ...
+                '&evSupp_EventAtTop_222,' , ...
                 'EventAtTop_ConstP.pooled4,' , ...
                 '"EventAtTop/AtomicSubsystem/CFS_Event",' , ...
-                '&evData_EventAtTop_222[0],' , ...
-                '&evData_EventAtTop_222[1],' , ...
-                '&evData_EventAtTop_222[2],' , ...
-                '&evData_EventAtTop_222[3],' , ...
+                'ECI_EVENT_DATA_DESC(ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_NONE),' , ...
+                '&evData1_EventAtTop_222,' , ...
+                '&evData2_EventAtTop_222,' , ...
+                '&evData3_EventAtTop_222,' , ...
+                '&evData4_EventAtTop_222,' , ...
                 '0' , ...
                 '},' , ...
                 '{ ECI_EVENT_4_DATA,' , ...
@@ -67,12 +70,14 @@ classdef Test_EventAtTop < cfetargettester.CfeTargetTester
                 '&EventAtTop_ConstP.pooled3,' , ...
                 '&EventAtTop_ConstP.pooled2,' , ...
                 '&evFlag_EventAtTop_212,' , ...
+                '&evSupp_EventAtTop_212,' , ...
                 'EventAtTop_ConstP.pooled4,' , ...
                 '"EventAtTop/CFS_Event",' , ...
-                '&evData_EventAtTop_212[0],' , ...
-                '&evData_EventAtTop_212[1],' , ...
-                '&evData_EventAtTop_212[2],' , ...
-                '&evData_EventAtTop_212[3],' , ...
+                'ECI_EVENT_DATA_DESC(ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_DOUBLE, ECI_EVENT_DATA_NONE),' , ...
+                '&evData1_EventAtTop_212,' , ...
+                '&evData2_EventAtTop_212,' , ...
+                '&evData3_EventAtTop_212,' , ...
+                '&evData4_EventAtTop_212,' , ...
                 '0' , ...
                 '},' , ...
                 '{ ECI_EVENT_0_DATA,' , ...
@@ -80,19 +85,64 @@ classdef Test_EventAtTop < cfetargettester.CfeTargetTester
                 '&EventAtTop_ConstP.pooled3,' , ...
                 '&EventAtTop_ConstP.pooled2,' , ...
                 '&evFlag_EventAtTop_213,' , ...
+                '&evSupp_EventAtTop_213,' , ...
                 'EventAtTop_ConstP.CFS_Event1_event_fmtstring,' , ...
                 '"EventAtTop/CFS_Event1",' , ...
+                'ECI_EVENT_DATA_DESC(ECI_EVENT_DATA_NONE, ECI_EVENT_DATA_NONE, ECI_EVENT_DATA_NONE, ECI_EVENT_DATA_NONE, ECI_EVENT_DATA_NONE),' , ...
                 '0,' , ...
                 '0,' , ...
                 '0,' , ...
                 '0,' , ...
                 '0' , ...
                 '},' , ...
-                '{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }' , ...
+                '{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }' , ...
                 '};            '    };
             
             testcase.checkCodeContents(patterns);
         end        
 
+        % Check the compact event table: data pointers in ECI_EventData,
+        % interned strings in ECI_EventStr and, with path IDs, no paths
+        % in the interface and a ground lookup file
+        function testCompactEvents(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_COMPACT_EVENTS__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_COMPACT_EVENTS__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...                     
+                '#define ECI_EVENT_TABLE_COMPACT 1' , ...
+                'static const ECI_EventStr_t ECI_EventStr = {' , ...
+                '"EventAtTop/AtomicSubsystem/CFS_Event"' , ...
+                'static const void * const ECI_EventData[] = {' , ...
+                '&evData1_EventAtTop_222,' , ...
+                'static const ECI_EvsCompact_t ECI_Events[] = {' , ...
+                '&evFlag_EventAtTop_222,' , ...
+                '{ 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }' };
+            patterns(1).DoesNotContainStrings = {'ECI_Evs_t'};
+            testcase.checkCodeContents(patterns);
+            
+            set_param(mdl, '__CFS_EVENT_PATH_IDS__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_EVENT_PATH_IDS__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).ContainsOrderedStrings = { ...                     
+                '#define ECI_EVENT_LOC_HASHED 1' , ...
+                'static const ECI_EvsCompact_t ECI_Events[] = {' , ...
+                cfs_path_id('EventAtTop/AtomicSubsystem/CFS_Event') };
+            patterns(1).DoesNotContainStrings = {'"EventAtTop/CFS_Event"'};
+            testcase.checkCodeContents(patterns);
+            
+            csvFile = fullfile(pwd, [mdl '_cfs_ert_rtw'], [mdl '_eci_events.csv']);
+            lookup = fileread(csvFile);
+            testcase.verifySubstring(lookup, [cfs_path_id('EventAtTop/CFS_Event1') ',']);
+            testcase.verifySubstring(lookup, '"EventAtTop/CFS_Event1"');
+        end        
+
     end
 end
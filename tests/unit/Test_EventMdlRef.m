@@ -4,11 +4,12 @@
 % Tests:
 %   - Event block in a model ref in muti-instance config
 %   - Event block in a model ref in single instance config
-%   - ...and there is no Event Table genrerated.
+%   - ...and the referenced model Event is in the top Event Table.
+%   - SIL Perf Marker in the model ref needs a Perf Marker ID Base
 %
 %     In multi-instance we should see a fatal build error.
-%     In single instance we get a warning, but should not
-%     create any event table information in the header.
+%     In single instance the build is clean and the Event Table
+%     of the top model includes the referenced model's event.
 
 classdef Test_EventMdlRef < cfetargettester.CfeTargetTester
     
@@ -48,32 +49,58 @@ classdef Test_EventMdlRef < cfetargettester.CfeTargetTester
         end
         
         % Verify that Event block in model ref context in single-instance
-        % will give a warning
-        %   (the warning is: "Block is being used in a Model Reference. 
-        %    This will not result in code being generated for CFS Event 
-        %    Tables")
+        % builds without warnings
         %
-        function testSingleInstanceWarning(testcase)  
-            import matlab.unittest.constraints.IssuesWarnings            
+        function testSingleInstanceNoWarning(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings            
            
             set_param(testcase.TestModelRef,'ModelReferenceNumInstancesAllowed', 'Single');
             save_system(testcase.TestModelRef);
-            % model build should give warning
-            testcase.verifyThat(@() testcase.generateCode(), ...
-                IssuesWarnings({'RTW:tlc:GenericWarn'}));                
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
         end
         
-        function testNoEventTableCreate(testcase)  
-        % In the case of the build in single instance, there should be 
-        % no Event Table data generated in interface header.
+        function testEventTableCreate(testcase)  
+        % In the case of the build in single instance, the Event Table
+        % in the top level interface header holds the referenced model
+        % event, from the manifest written by the referenced model build.
             patterns(1).FileName = [testcase.TestInterface];          
-            patterns(1).DoesNotContainStrings = { ...                     
+            patterns(1).ContainsOrderedStrings = { ...                     
+                '#include "EventBot.h"', ...
                 '#define ECI_EVENT_TABLE_DEFINED' , ...
-                'static const ECI_Evs_t ECI_Events[] = {' ...
+                'static const ECI_Evs_t ECI_Events[] = {', ...
+                '&evFlag_EventBot_' ...
                 };
             
             testcase.checkCodeContents(patterns);        
         end        
         
+
+        % Verify that a SIL Perf Marker in the referenced model needs the
+        % Perf Marker ID Base option, the model ref has no perf ID
+        %
+        function testPerfMarkerBase(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            ref = testcase.TestModelRef;
+            load_system('cfs_library');
+            blk = add_block('cfs_library/CFS_Perf_Marker', [ref '/Perf_Marker'], ...
+                            'perf_name', 'bot');
+            save_system(ref);
+            testcase.addTeardown(@() save_system(ref));
+            testcase.addTeardown(@() set_param(ref, '__CFS_PERF_MARKER_BASE__', ''));
+            testcase.addTeardown(@() delete_block(blk));
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+            
+            set_param(ref, '__CFS_PERF_MARKER_BASE__', '100');
+            save_system(ref);
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);
+            
+            perfIds = fileread(fullfile(testcase.workingFixture.Folder, ...
+                'slprj', 'cfs_ert', ref, [ref '_perfids.h']));
+            testcase.verifySubstring(perfIds, ...
+                ['#define ' upper(ref) '_PERF_MARKER_BASE  (100)']);
+        end
     end
 end
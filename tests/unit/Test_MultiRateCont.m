@@ -7,6 +7,10 @@
 %   - Model is muti-rate
 %   - Model has no CFE blocks
 %   - Model has DWork states and state table is turned on
+%   - Multitasking build creates the partition task table
+%   - Task Cores pins the tasks, and must list a core per task ID with
+%     -1 for the base rate
+%   - Warm start is rejected for continuous states
 %
 
 classdef Test_MultiRateCont < cfetargettester.CfeTargetTester
@@ -129,5 +133,84 @@ classdef Test_MultiRateCont < cfetargettester.CfeTargetTester
             testcase.checkCodeContents(patterns);
         end        
 
+        % Check the task table when the model is built multitasking.
+        % Each rate after the base rate gets its own task entry point.
+        function testMultiTaskTable(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, 'SolverMode', 'MultiTasking');
+            testcase.addTeardown(@() set_param(mdl, 'SolverMode', 'SingleTasking'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];
+            patterns(1).ContainsOrderedPatterns = { ...
+                '#define\s*ECI_TASK_TABLE_DEFINED\s*1', ...
+                ['static\s*void\s*' mdl '_Task\d+\(void\)'], ...
+                'static\s*const\s*ECI_Task_t\s*ECI_Tasks\[\]\s*=\s*{', ...
+                ['\s*{\s*\x22' upper(mdl) '_T\d+\x22,\s*' mdl '_Task\d+,'], ...
+                '\s*{\s*NULL,\s*NULL,\s*0,\s*-1,\s*0}'};
+            
+            testcase.checkCodeContents(patterns);
+        end
+
+        % Check that Task Cores sets the core of each task, one entry per
+        % task ID, and that a list of the wrong length or pinning the base
+        % rate is rejected
+        function testMultiTaskCores(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, 'SolverMode', 'MultiTasking');
+            testcase.addTeardown(@() set_param(mdl, 'SolverMode', 'SingleTasking'));
+            testcase.addTeardown(@() set_param(mdl, '__CFS_TASK_CORES__', ''));
+            
+            % a single core is not one per task ID
+            set_param(mdl, '__CFS_TASK_CORES__', '1');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+            
+            % find the task IDs from a build without cores
+            set_param(mdl, '__CFS_TASK_CORES__', '');
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);
+            hdr = fileread(fullfile(testcase.workingFixture.Folder, ...
+                [mdl '_cfs_ert_rtw'], testcase.TestInterface));
+            tok = regexp(hdr, [mdl '_Task(\d+),'], 'tokens');
+            tids = cellfun(@(c) str2double(c{1}), tok);
+            numTids = max(tids) + 1;
+            tid = tids(1);
+            firstTid = min(tids);
+            
+            % the base rate runs on the app main task, its entries must
+            % be -1
+            set_param(mdl, '__CFS_TASK_CORES__', strjoin(arrayfun(@num2str, ...
+                0:numTids-1, 'UniformOutput', false), ','));
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+            
+            % core N for task ID N after the base rate
+            set_param(mdl, '__CFS_TASK_CORES__', strjoin(arrayfun(@num2str, ...
+                [-ones(1, firstTid) firstTid:numTids-1], 'UniformOutput', false), ','));
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);
+            
+            patterns(1).FileName = [testcase.TestInterface];
+            patterns(1).ContainsPatterns = { ...
+                sprintf('{\\s*\\x22%s_T%d\\x22,\\s*%s_Task%d,\\s*\\d+,\\s*%d,\\s*%d}', ...
+                        upper(mdl), tid, mdl, tid, tid, tid) };
+            testcase.checkCodeContents(patterns);
+        end
+
+        % Check that warm start is rejected, the continuous states need 
+        % the solver set up by model_initialize.
+        function testWarmStartContStatesFail(testcase)  
+            import matlab.unittest.constraints.Throws
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_WARM_START__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_WARM_START__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end
+
     end
 end
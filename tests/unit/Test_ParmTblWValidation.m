@@ -6,6 +6,8 @@
 %   - Model defines correct param table structure in interface header
 %   - Model generates definition of table validation function
 %   - Model generates definition of parameter table
+%   - createCfsTblImage writes the cFE file and table headers and the 
+%     table data, row-major arrays, and rejects complex elements
 %
 
 classdef Test_ParmTblWValidation < cfetargettester.CfeTargetTester
@@ -117,5 +119,90 @@ classdef Test_ParmTblWValidation < cfetargettester.CfeTargetTester
             testcase.checkCodeContents(patterns);
         end        
 
+
+        % Check the table image written by createCfsTblImage: the 64 byte 
+        % cFE file header, the 52 byte table header and the big endian 
+        % table data laid out as the bus
+        function testTblImage(testcase)
+            import matlab.unittest.constraints.Throws
+            
+            bus = Simulink.Bus;
+            el = Simulink.BusElement;
+            el.Name = 'mode';
+            el.DataType = 'uint8';
+            bus.Elements(1) = el;
+            el = Simulink.BusElement;
+            el.Name = 'gain';
+            el.DataType = 'double';
+            bus.Elements(2) = el;
+            el = Simulink.BusElement;
+            el.Name = 'lut';
+            el.DataType = 'int16';
+            el.Dimensions = [2 3];
+            bus.Elements(3) = el;
+            
+            value.mode = 3;
+            value.gain = 2.5;
+            value.lut  = int16([1 2 3; 4 5 6]);
+            
+            tblFile = fullfile(testcase.workingFixture.Folder, 'parmTbl.tbl');
+            bytes = createCfsTblImage(tblFile, value, 'parmTbl', testcase.TestModel, ...
+                                      'Bus', bus, 'Endian', 'big', ...
+                                      'SpacecraftID', 42, 'Time', [100 200]);
+            
+            fid = fopen(tblFile, 'r');
+            fileBytes = fread(fid, inf, '*uint8');
+            fclose(fid);
+            testcase.verifyEqual(fileBytes, bytes);
+            testcase.verifyEqual(numel(bytes), 64 + 52 + 32);
+            
+            be32 = @(b) double(swapbytes(typecast(uint8(b(:)'), 'uint32')));
+            
+            % cFE file header
+            testcase.verifyEqual(char(bytes(1:4)'), 'cFE1');
+            testcase.verifyEqual(be32(bytes(5:8)), 8);          % SubType
+            testcase.verifyEqual(be32(bytes(9:12)), 64);        % Length
+            testcase.verifyEqual(be32(bytes(13:16)), 42);       % SpacecraftID
+            testcase.verifyEqual(be32(bytes(25:28)), 100);      % Seconds
+            testcase.verifyEqual(be32(bytes(29:32)), 200);      % Subseconds
+            desc = [testcase.TestModel ' parmTbl'];
+            testcase.verifyEqual(char(bytes(33:32+numel(desc))'), desc);
+            testcase.verifyEqual(bytes(33+numel(desc):64), ...
+                                 zeros(32-numel(desc), 1, 'uint8'));
+            
+            % cFE table header
+            testcase.verifyEqual(be32(bytes(65:68)), 0);        % Reserved
+            testcase.verifyEqual(be32(bytes(69:72)), 0);        % Offset
+            testcase.verifyEqual(be32(bytes(73:76)), 32);       % NumBytes
+            tblName = [testcase.TestModel '.parmTbl'];
+            testcase.verifyEqual(char(bytes(77:76+numel(tblName))'), tblName);
+            testcase.verifyEqual(bytes(77+numel(tblName):116), ...
+                                 zeros(40-numel(tblName), 1, 'uint8'));
+            
+            % Table data: mode, 7 pad bytes, gain, lut column major, 4 pad
+            lutBytes = @(v) reshape(flipud(reshape( ...
+                typecast(int16(v), 'uint8'), 2, [])), [], 1);
+            [~, ~, hostEndian] = computer;
+            gainBytes = typecast(2.5, 'uint8')';
+            if hostEndian == 'L'
+                gainBytes = flipud(gainBytes);
+            else
+                lutBytes = @(v) typecast(int16(v), 'uint8')';
+            end
+            testcase.verifyEqual(bytes(117:end), ...
+                [uint8(3) ; zeros(7, 1, 'uint8') ; gainBytes ; ...
+                 lutBytes([1 4 2 5 3 6]) ; zeros(4, 1, 'uint8')]);
+            
+            % Row-major arrays are stored row by row
+            bytes = createCfsTblImage('', value, 'parmTbl', testcase.TestModel, ...
+                                      'Bus', bus, 'Endian', 'big', ...
+                                      'ArrayLayout', 'Row-major');
+            testcase.verifyEqual(bytes(133:144), lutBytes(1:6));
+            
+            % Complex elements are rejected
+            value.gain = 2.5 + 1i;
+            testcase.verifyThat(@() createCfsTblImage('', value, 'parmTbl', ...
+                testcase.TestModel, 'Bus', bus), Throws('createCfsTblImage:complex'));
+        end        
     end
 end
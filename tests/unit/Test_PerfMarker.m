@@ -0,0 +1,95 @@
+% 
+% CFE SIL Interface code generation test cases for:
+% Model: PerfMarker (built by the test from library blocks)
+% Tests:
+%   - SIL Perf Marker IDs, and markers around an atomic subsystem
+%   - Invalid marker name is rejected
+%   - Marker in a subsystem that is not atomic is rejected
+%
+
+classdef Test_PerfMarker < cfetargettester.CfeTargetTester
+
+    properties
+        TestModel = 'PerfMarker'
+        TestInterface = 'eci_interface.h'
+        TestData  = 'test_data.mat'
+    end
+
+    methods(TestClassSetup)
+        % PerfMarker: In1 -> atomic subsystem ctrl (Gain and the SIL Perf
+        % Marker "ctrl") -> Out1, with the cFS target settings of CDSBasic
+        function createModel(testcase)
+                mdl = testcase.TestModel;
+                load_system('CDSBasic');
+                load_system('cfs_library');
+                new_system(mdl);
+                testcase.addTeardown(@() close_system(mdl, 0));
+                cs = attachConfigSetCopy(mdl, getActiveConfigSet('CDSBasic'), true);
+                setActiveConfigSet(mdl, cs.Name);
+                close_system('CDSBasic', 0);
+                testcase.configModelForTesting(mdl);
+
+                ss = [mdl '/ctrl'];
+                add_block('simulink/Ports & Subsystems/In1', [mdl '/u']);
+                add_block('simulink/Ports & Subsystems/Atomic Subsystem', ss, ...
+                          'RTWSystemCode', 'Nonreusable function');
+                add_block('simulink/Ports & Subsystems/Out1', [mdl '/y']);
+                add_line(mdl, 'u/1', 'ctrl/1');
+                add_line(mdl, 'ctrl/1', 'y/1');
+
+                delete_line(ss, 'In1/1', 'Out1/1');
+                add_block('simulink/Math Operations/Gain', [ss '/Gain'], 'Gain', '2');
+                add_line(ss, 'In1/1', 'Gain/1');
+                add_line(ss, 'Gain/1', 'Out1/1');
+                add_block('cfs_library/CFS_Perf_Marker', [ss '/Perf_Marker'], ...
+                          'perf_name', 'ctrl');
+        end
+    end
+
+    methods(Test)
+        % Check the perf IDs, and that the markers bracket the output code
+        % of the atomic subsystem
+        function testPerfMarker(testcase)
+            import matlab.unittest.constraints.IssuesNoWarnings
+
+            mdl = testcase.TestModel;
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);
+
+            patterns(1).FileName = [mdl '_perfids.h'];
+            patterns(1).ContainsOrderedStrings = { ...
+                ['#define ' upper(mdl) '_PERF_MARKER_BASE  (' upper(mdl) '_PERF_ID + 1)'], ...
+                ['#define ' upper(mdl) '_CTRL_PERF_ID  (' upper(mdl) '_PERF_MARKER_BASE + 0)'] };
+            patterns(2).FileName = [mdl '.c'];
+            patterns(2).ContainsOrderedStrings = { ...
+                ['ECI_PERF_ENTRY(' upper(mdl) '_CTRL_PERF_ID);'], ...
+                ['ECI_PERF_EXIT(' upper(mdl) '_CTRL_PERF_ID);'] };
+
+            testcase.checkCodeContents(patterns);
+        end
+
+        % A marker name which is not a C identifier is rejected
+        function testPerfMarkerNameFail(testcase)
+            import matlab.unittest.constraints.Throws
+
+            blk = [testcase.TestModel '/ctrl/Perf_Marker'];
+            set_param(blk, 'perf_name', 'ctrl-loop');
+            testcase.addTeardown(@() set_param(blk, 'perf_name', 'ctrl'));
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end
+
+        % A marker in a triggered subsystem is rejected, only atomic
+        % subsystems and the root are bracketed
+        function testPerfMarkerTriggeredFail(testcase)
+            import matlab.unittest.constraints.Throws
+
+            mdl  = testcase.TestModel;
+            trig = add_block('simulink/Ports & Subsystems/Trigger', [mdl '/ctrl/Trigger']);
+            src  = add_block('simulink/Sources/Constant', [mdl '/trig']);
+            lh   = add_line(mdl, 'trig/1', 'ctrl/Trigger');
+            testcase.addTeardown(@() delete_block([trig src]));
+            testcase.addTeardown(@() delete_line(lh));
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end
+
+    end
+end
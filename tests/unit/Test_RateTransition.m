@@ -0,0 +1,143 @@
+% 
+% CFE SIL Interface code generation test cases for:
+% Model: RateTransition (built by the test from library blocks)
+% Tests:
+%   - SIL Rate Transition output matches a built-in Rate Transition, fast
+%     to slow and slow to fast
+%   - Generated code exchanges the triple buffer with ECI_RT_XCHG in a
+%     multitasking build
+%
+
+classdef Test_RateTransition < cfetargettester.CfeTargetTester
+
+    properties
+        TestModel = 'RateTransition'
+        TestInterface = 'eci_interface.h'
+        TestData  = 'test_data.mat'
+    end
+
+    methods(TestClassSetup)
+        % RateTransition, base rate 0.1 s, two paths each compared with a
+        % built-in reference.  The SIL block publishes in its update, so
+        % the reader sees the input of the previous writer step:
+        %   f2s: 0.1 s clock -> SIL RT (0.5 s)                      -> y1
+        %        0.1 s clock -> Unit Delay -> Rate Transition (0.5 s) -> y2
+        %   s2f: 0.5 s clock -> SIL RT (0.1 s)                      -> y3
+        %        0.5 s clock -> Rate Transition (0.1 s) -> Unit Delay -> y4
+        function createModel(testcase)
+                mdl = testcase.TestModel;
+                load_system('CDSBasic');
+                load_system('cfs_library');
+                new_system(mdl);
+                testcase.addTeardown(@() close_system(mdl, 0));
+                cs = attachConfigSetCopy(mdl, getActiveConfigSet('CDSBasic'), true);
+                setActiveConfigSet(mdl, cs.Name);
+                close_system('CDSBasic', 0);
+                testcase.configModelForTesting(mdl);
+                set_param(mdl, 'SolverType', 'Fixed-step', ...
+                               'Solver', 'FixedStepDiscrete', ...
+                               'FixedStep', '0.1', 'StopTime', '5', ...
+                               'EnableMultiTasking', 'off', ...
+                               'SaveOutput', 'on', 'SaveFormat', 'Array', ...
+                               'ReturnWorkspaceOutputs', 'on');
+
+                add_block('simulink/Sources/Digital Clock', [mdl '/fast'], 'SampleTime', '0.1');
+                add_block('simulink/Sources/Digital Clock', [mdl '/slow'], 'SampleTime', '0.5');
+                add_block('cfs_library/CFS_Rate_Transition', [mdl '/sil_f2s'], ...
+                          'rt_ic', '0', 'rt_ts', '0.5');
+                add_block('cfs_library/CFS_Rate_Transition', [mdl '/sil_s2f'], ...
+                          'rt_ic', '0', 'rt_ts', '0.1');
+                add_block('simulink/Discrete/Unit Delay', [mdl '/dly_f2s'], ...
+                          'SampleTime', '0.1');
+                add_block('simulink/Discrete/Unit Delay', [mdl '/dly_s2f'], ...
+                          'SampleTime', '0.1');
+                add_block('simulink/Signal Attributes/Rate Transition', [mdl '/ref_f2s']);
+                add_block('simulink/Signal Attributes/Rate Transition', [mdl '/ref_s2f']);
+                testcase.setBuiltInRt([mdl '/ref_f2s'], '0.5');
+                testcase.setBuiltInRt([mdl '/ref_s2f'], '0.1');
+                for k = 1:4
+                    add_block('simulink/Ports & Subsystems/Out1', sprintf('%s/y%d', mdl, k));
+                end
+
+                add_line(mdl, 'fast/1', 'sil_f2s/1');
+                add_line(mdl, 'sil_f2s/1', 'y1/1');
+                add_line(mdl, 'fast/1', 'dly_f2s/1');
+                add_line(mdl, 'dly_f2s/1', 'ref_f2s/1');
+                add_line(mdl, 'ref_f2s/1', 'y2/1');
+                add_line(mdl, 'slow/1', 'sil_s2f/1');
+                add_line(mdl, 'sil_s2f/1', 'y3/1');
+                add_line(mdl, 'slow/1', 'ref_s2f/1');
+                add_line(mdl, 'ref_s2f/1', 'dly_s2f/1');
+                add_line(mdl, 'dly_s2f/1', 'y4/1');
+        end
+    end
+
+    methods
+        % Built-in Rate Transition as a plain sample and hold at the
+        % given output sample time (no extra buffering or latency)
+        function setBuiltInRt(testcase, blk, ts) %#ok<INUSL>
+            set_param(blk, 'Integrity', 'off', 'Deterministic', 'off', 'X0', '0');
+            if isfield(get_param(blk, 'ObjectParameters'), 'OutPortSampleTimeOpt')
+                set_param(blk, 'OutPortSampleTimeOpt', 'Specify');
+            end
+            set_param(blk, 'OutPortSampleTime', ts);
+        end
+    end
+
+    methods(Test)
+        % The SIL Rate Transition output must match the built-in reference
+        % at every base rate step
+        function testSimulationMatchesBuiltIn(testcase)
+            import matlab.unittest.constraints.IssuesNoWarnings
+
+            mdl = testcase.TestModel;
+            testcase.verifyThat(@() testcase.normalModeSim(mdl), IssuesNoWarnings);
+            simOut = sim(mdl);
+            y = simOut.get('yout');
+
+            testcase.verifySize(y, [51 4]);
+            testcase.verifyEqual(y(:,1), y(:,2), 'AbsTol', 1e-12);
+            testcase.verifyEqual(y(:,3), y(:,4), 'AbsTol', 1e-12);
+            % The paths are not trivially equal: both carry the clock
+            testcase.verifyEqual(y(end,1), 4.9, 'AbsTol', 1e-12);
+            testcase.verifyEqual(y(end,3), 4.5, 'AbsTol', 1e-12);
+        end
+
+        % The generated code of a multitasking build must exchange the
+        % triple buffer indices with ECI_RT_XCHG, reading in the output
+        % and publishing in the update of the block
+        function testTripleBufferCode(testcase)
+            import matlab.unittest.constraints.IssuesNoWarnings
+
+            mdl = testcase.TestModel;
+            % Built-in Rate Transitions must protect the data in a
+            % multitasking model; they are not the subject of this test
+            set_param([mdl '/ref_f2s'], 'Integrity', 'on', 'Deterministic', 'on');
+            set_param([mdl '/ref_s2f'], 'Integrity', 'on', 'Deterministic', 'on');
+            set_param(mdl, 'EnableMultiTasking', 'on');
+            testcase.addTeardown(@() set_param(mdl, 'EnableMultiTasking', 'off'));
+            testcase.addTeardown(@() testcase.setBuiltInRt([mdl '/ref_f2s'], '0.5'));
+            testcase.addTeardown(@() testcase.setBuiltInRt([mdl '/ref_s2f'], '0.1'));
+
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);
+
+            patterns(1).FileName = [mdl '.c'];
+            patterns(1).ContainsPatterns = { ...
+                'if \(ECI_RT_LOAD\(&\w+\.\w+\) & ECI_RT_NEW_DATA\)', ...
+                '= ECI_RT_XCHG\(&\w+\.\w+, \w+\.\w+\) & ECI_RT_IDX_MASK;', ...
+                '= ECI_RT_XCHG\(&\w+\.\w+, \w+\.\w+ \| ECI_RT_NEW_DATA\) & ECI_RT_IDX_MASK;' };
+            testcase.checkCodeContents(patterns);
+
+            % The atomic exchange macros are defined with the model code
+            buildDir = fullfile(testcase.workingFixture.Folder, [mdl '_cfs_ert_rtw']);
+            hdrs = dir(fullfile(buildDir, '*.h'));
+            code = strjoin(cellfun(@(f) fileread(fullfile(buildDir, f)), ...
+                                   {hdrs.name}, 'UniformOutput', false), newline);
+            testcase.verifySubstring(code, ...
+                '#define ECI_RT_XCHG(p, v)  __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)');
+            testcase.verifySubstring(code, ...
+                '#define ECI_RT_LOAD(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)');
+        end
+
+    end
+end
@@ -4,6 +4,8 @@
 % Tests:
 %   - CFS Time blocks at top model level
 %   - CFS Time block in atomic (nonvirtual subsystem)
+%   - Timestamp table time source: loadCfsTimestamps, simulation, and no
+%     table or row index in the generated code
 %
 
 classdef Test_TimeAtTop < cfetargettester.CfeTargetTester
@@ -76,6 +78,15 @@ classdef Test_TimeAtTop < cfetargettester.CfeTargetTester
                 'static ECI_Msg_t ECI_MsgRcv[] = {'  , ...
                 '{ 0, NULL, 0, NULL, NULL }'  , ...
                 '};'  }   ;            
+
+            % Step time is converted once per step in the interface
+            patterns(3).FileName = [testcase.TestInterface];          
+            patterns(3).ContainsOrderedStrings = { ...                       
+                '#define ECI_STEP_TIMESTAMP_DEFINED'  , ...
+                'extern real_T ECI_Step_Time;'  , ...
+                '#define ECI_STEP_FCN'  , ...
+                'ECI_UPDATE_STEP_TIME();'  , ...
+                'TimeAtTop_step();'  }   ;            
             
             testcase.checkCodeContents(patterns);
         end   
@@ -87,8 +98,7 @@ classdef Test_TimeAtTop < cfetargettester.CfeTargetTester
             patterns(1).ContainsOrderedStrings = { ...
                 'void TimeAtTop_step(void)', ...
                 '{', ...
-                'TimeAtTop_Y.Out1 = ((real_T)ECI_Step_TimeStamp.Seconds + ((real_T)', ...
-                'ECI_Step_TimeStamp.Subseconds/4294967296.0));', ...
+                'TimeAtTop_Y.Out1 = ECI_Step_Time;', ...
                 'TimeAtTop_AtomicSubsystem(&TimeAtTop_Y.Out2);', ...
                 '}'   };
                       
@@ -102,12 +112,50 @@ classdef Test_TimeAtTop < cfetargettester.CfeTargetTester
             patterns(1).ContainsOrderedStrings = { ...
                 'void TimeAtTop_AtomicSubsystem(real_T *rty_Out1)', ...
                 '{', ...
-                '(*rty_Out1) = ((real_T)ECI_Step_TimeStamp.Seconds + ((real_T)', ...
-                'ECI_Step_TimeStamp.Subseconds/4294967296.0));', ...
+                '(*rty_Out1) = ECI_Step_Time;', ...
                 '}'   };                                       
                       
             testcase.checkCodeContents(patterns);
         end        
         
+        % Check the timestamp table time source: the table loaded from a 
+        % text file drives the simulation, and the generated code has 
+        % neither the table nor its row index (tsIndex)
+        function testTimestampTable(testcase)             
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            csvFile = fullfile(testcase.workingFixture.Folder, 'steps.csv');
+            dlmwrite(csvFile, (0:0.25:10)');
+            tstamps = loadCfsTimestamps(csvFile);
+            testcase.verifyClass(tstamps, 'uint32');
+            testcase.verifySize(tstamps, [41 2]);
+            testcase.verifyEqual(tstamps(2,:), uint32([0 2^30]));
+            testcase.verifyEqual(tstamps(end,:), uint32([10 0]));
+            
+            assignin('base', 'tstamps', tstamps);
+            testcase.addTeardown(@() evalin('base', 'clear tstamps'));
+            blks = find_system(mdl, 'LookUnderMasks', 'all', ...
+                               'FunctionName', 'cfs_gnc_time');
+            for k = 1:numel(blks)
+                prev = get_param(blks{k}, 'SParameter4');
+                testcase.addTeardown(@() set_param(blks{k}, ...
+                    'SParameter4', prev, 'SParameter5', 'uint32([0 0])'));
+                set_param(blks{k}, 'SParameter4', 'Timestamp table', ...
+                                   'SParameter5', 'tstamps');
+            end
+            
+            testcase.verifyThat(@() testcase.normalModeSim(mdl), IssuesNoWarnings);                
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [mdl '.c'];          
+            patterns(1).ContainsStrings = { 'TimeAtTop_Y.Out1 = ECI_Step_Time;' };
+            patterns(1).DoesNotContainStrings = { 'tsIndex', '2.3283064365386962890625E-10' };
+            patterns(2).FileName = [mdl '.h'];          
+            patterns(2).DoesNotContainStrings = { 'tsIndex' };
+                      
+            testcase.checkCodeContents(patterns);
+        end        
+        
     end
 end
@@ -3,6 +3,17 @@
 % Model: TlmMessageSingle
 % Tests:
 %   - Check for a single Tlm message entry in Send and Recieve table
+%   - Performance housekeeping payload and step timing
+%   - Memory report, and a RAM budget below it fails the build
+%   - Aggregate telemetry packet header, directory and pack
+%   - Buffer Sample Policy rejected on a scalar telemetry input
+%   - Buffer Sample Policy table with its count and times inputs
+%   - Managed CCSDS header setup and update
+%   - Alignment attribute on a telemetry input
+%   - Namespaced interface with a model registration record
+%   - Two namespaced interfaces compile in one file
+%   - Two namespaced models with an aggregate of the same name compile
+%     in one file
 %
 
 classdef Test_TlmMessageSingle < cfetargettester.CfeTargetTester
@@ -59,5 +70,291 @@ classdef Test_TlmMessageSingle < cfetargettester.CfeTargetTester
             testcase.checkCodeContents(patterns);
         end        
 
+        % Check the performance housekeeping payload and the step timing
+        % added to ECI_STEP_FCN when the option is selected
+        function testPerfHousekeeping(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_GEN_PERF_HK__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_GEN_PERF_HK__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#define ECI_HK_PERF_DEFINED 1', ...
+                'uint32_T sndCount[ECI_HK_NUM_SND];', ...
+                '} ECI_PerfHk_t;', ...
+                'static void ECI_PerfHkStepEnd(void)', ...
+                'static void ECI_PerfHkReport(ECI_PerfHk_t* dst)', ...
+                '#define ECI_STEP_FCN', ...
+                'ECI_HK_STEP_BEGIN();', ...
+                'ECI_HK_STEP_END();' }   ;         
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % Check the memory report lists the message buffer and the ECI
+        % tables, and that a RAM budget below it stops code generation
+        function testMemoryReport(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_MEM_REPORT__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_MEM_REPORT__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            reportFile = fullfile(pwd, [mdl '_cfs_ert_rtw'], [mdl '_eci_memory.json']);
+            testcase.verifyEqual(exist(reportFile, 'file'), 2);
+            report = jsondecode(fileread(reportFile));
+            names  = {report.objects.name};
+            testcase.verifyTrue(any(strcmp(names, 'ECI_MsgSnd')));
+            testcase.verifyTrue(any(strcmp({report.objects.category}, 'message')));
+            testcase.verifyGreaterThan(report.ram, 0);
+            % ECI_Msg_t is a message ID and four pointers, padded
+            msgSnd = report.objects(strcmp(names, 'ECI_MsgSnd'));
+            testcase.verifyEqual(mod(msgSnd.size, 5 * report.pointerSize), 0);
+            
+            set_param(mdl, '__CFS_MEM_BUDGET__', '1,0');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_MEM_BUDGET__', ''));
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % Check the managed header setup in ECI_INIT_FCN and the header
+        % update after the step in ECI_STEP_FCN
+        function testManagedHeaders(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_MANAGED_HDRS__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_MANAGED_HDRS__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#define ECI_HDR_MANAGED 1', ...
+                'static const uint8_T ECI_MsgSndHdr[] = {', ...
+                'static void ECI_HdrInit(void)', ...
+                'static void ECI_HdrUpdate(void)', ...
+                '#define ECI_INIT_FCN', ...
+                'ECI_HdrInit();', ...
+                '#define ECI_STEP_FCN', ...
+                'ECI_HdrUpdate();' }   ;         
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % Check the aggregate packet header, its directory initializer and
+        % the pack after the step.  The container is sent in place of its
+        % member.
+        function testAggregate(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            testcase.setSignalAttributes(mdl, 'def1', 'Aggregate', 'hk');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [mdl '_tlm_aggregate.h'];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#define ECI_INLINE', ...
+                '} ECI_AggDir_t;', ...
+                'static ECI_INLINE int ECI_AggUnpack(const void* pkt, uint16_T mid, void* msg, size_t msgSize)', ...
+                'ECI_AggDir_t dir[1];', ...
+                'uint8_T      def1[sizeof(NestedBus) - ECI_TLM_HDR_SIZE];', ...
+                '} hk_Agg_t;', ...
+                'typedef char hk_Agg_t_SizeCheck[(sizeof(hk_Agg_t) <= 65535U) ? 1 : -1];' }   ;         
+            patterns(2).FileName = [testcase.TestInterface];          
+            patterns(2).ContainsOrderedStrings = { ...           
+                ['#include "' mdl '_tlm_aggregate.h"'], ...
+                '#define ECI_TLM_AGGREGATE_DEFINED 1', ...
+                'static hk_Agg_t hk_agg = { {0}, 1, 0, {', ...
+                '{ NESTEDBUS_DEF1_MID, (uint16_T)offsetof(hk_Agg_t, def1), (uint16_T)sizeof(((hk_Agg_t*)0)->def1), 0},', ...
+                '#define ECI_TLM_AGGREGATE_PACK()', ...
+                '(void)memcpy(hk_agg.def1, (const uint8_T*)(&def1) + ECI_TLM_HDR_SIZE, sizeof(hk_agg.def1));', ...
+                'static ECI_Msg_t ECI_MsgSnd[] = {', ...
+                '{ HK_AGG_MID, &hk_agg, sizeof(hk_Agg_t), NULL, NULL },', ...
+                '#define ECI_STEP_FCN', ...
+                'ECI_TLM_AGGREGATE_PACK();' }   ;         
+            patterns(2).DoesNotContainStrings = { ...
+                '{ NESTEDBUS_DEF1_MID, &def1, sizeof(NestedBus), NULL, NULL },' };
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % The Buffer Sample Policy on a telemetry input that is not an
+        % array of the message bus should fail the build
+        function testSamplePolicyScalarFail(testcase)  
+            import matlab.unittest.constraints.Throws
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'SamplePolicy', 'Buffer', 'SampleCount', 'abc1_count');
+            
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % The Buffer Sample Policy on an array input should generate the
+        % ECI_TlmSamples table with the count and times inputs, and a 
+        % Sample Times input shorter than the buffer should fail the build
+        function testSamplePolicyBuffer(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            mdl  = testcase.TestModel;
+            blk  = [mdl '/In1'];
+            dims = get_param(blk, 'PortDimensions');
+            set_param(blk, 'PortDimensions', '4');
+            testcase.addTeardown(@() set_param(blk, 'PortDimensions', dims));
+            testcase.addExportedInport(mdl, 'abc1_count', 'uint32', '1');
+            testcase.addExportedInport(mdl, 'abc1_times', 'double', '4');
+            testcase.setSignalAttributes(mdl, 'abc1', 'SamplePolicy', 'Buffer', ...
+                'SampleCount', 'abc1_count', 'SampleTimes', 'abc1_times');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestInterface];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#include <string.h>', ...
+                'static ECI_Msg_t ECI_MsgRcv[] = {' , ...
+                '#define ECI_TLM_SAMPLES_DEFINED 1', ...
+                'static const ECI_TlmSamples_t ECI_TlmSamples[] = {', ...
+                '{ NESTEDBUS_ABC1_MID, &ECI_MsgRcv[0], 4, &abc1_count, &abc1_times[0]},', ...
+                '{0,NULL,0,NULL,NULL}', ...
+                'static int ECI_TlmSampleAdd(uint32_T mid, const void* msg, size_t size, real_T time)', ...
+                'static void ECI_TlmSampleClear(void)' }   ;         
+            
+            testcase.checkCodeContents(patterns);
+            
+            set_param([mdl '/abc1_times'], 'PortDimensions', '3');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % The Alignment attribute should align the message definition and
+        % its declaration, and a non power of 2 should fail the build
+        function testAlignment(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            import matlab.unittest.constraints.Throws
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'Alignment', '32');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [testcase.TestModel '.h'];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '#include "eci_aligned.h"', ...
+                'extern ECI_ALIGNED(32)' }   ;         
+            patterns(2).FileName = [testcase.TestModel '.c'];          
+            patterns(2).ContainsStrings = {'ECI_ALIGNED(32)'};         
+            patterns(3).FileName = 'eci_aligned.h';          
+            patterns(3).ContainsStrings = {'#define ECI_ALIGNED(n)'};         
+            
+            testcase.checkCodeContents(patterns);
+            
+            testcase.setSignalAttributes(testcase.TestModel, 'abc1', ...
+                'Alignment', '24');
+            testcase.verifyThat(@() testcase.generateCode(), Throws(''));
+        end        
+
+        % The namespaced interface should prefix the tables with the model
+        % name, register them in <model>_ECI_Model and undefine its macros
+        function testNamespacedInterface(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl = testcase.TestModel;
+            set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'off'));
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            
+            patterns(1).FileName = [mdl '_eci_interface.h'];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                ['static ECI_Msg_t ' mdl '_ECI_MsgSnd[] = {'], ...
+                ['static ECI_Msg_t ' mdl '_ECI_MsgRcv[] = {'], ...
+                ['static void ' mdl '_ECI_ModelStep(void)'], ...
+                ['static const ECI_Model_t ' mdl '_ECI_Model = {'], ...
+                '#undef ECI_STEP_FCN' }   ;         
+            patterns(1).DoesNotContainStrings = {'static ECI_Msg_t ECI_MsgSnd[]'};
+            
+            testcase.checkCodeContents(patterns);
+        end        
+
+        % Two namespaced interfaces must compile in one file: every file 
+        % scope name either has the model prefix or is shared (extern)
+        function testNamespacedInterfacePair(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl   = testcase.TestModel;
+            other = 'CmdMessageSingle';
+            load_system(other);
+            testcase.addTeardown(@() close_system(other, 0));
+            testcase.configModelForTesting(other);
+            set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'off'));
+            set_param(other, '__CFS_NAMESPACE_INTERFACE__', 'on');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            rtwbuild(other, 'ForceTopModelBuild', true);
+            
+            folder = testcase.workingFixture.Folder;
+            src    = fullfile(folder, 'eci_interface_pair.c');
+            fid    = fopen(src, 'w');
+            fprintf(fid, '#include "%s_eci_interface.h"\n', mdl);
+            fprintf(fid, '#include "%s_eci_interface.h"\n', other);
+            fclose(fid);
+            
+            testcase.verifyThat(@() mex('-c', ...
+                ['-I' fullfile(folder, [mdl '_cfs_ert_rtw'])], ...
+                ['-I' fullfile(folder, [other '_cfs_ert_rtw'])], ...
+                ['-I' fileparts(which('eci_app.h'))], src), IssuesNoWarnings);
+        end        
+
+        % Two namespaced models that both have an aggregate "hk" must 
+        % compile in one file: the container types have the model prefix
+        function testNamespacedAggregatePair(testcase)  
+            import matlab.unittest.constraints.IssuesNoWarnings
+            
+            mdl   = testcase.TestModel;
+            other = 'CmdTlmMessageMultiple';
+            load_system(other);
+            testcase.addTeardown(@() close_system(other, 0));
+            testcase.configModelForTesting(other);
+            set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'on');
+            testcase.addTeardown(@() set_param(mdl, '__CFS_NAMESPACE_INTERFACE__', 'off'));
+            set_param(other, '__CFS_NAMESPACE_INTERFACE__', 'on');
+            testcase.setSignalAttributes(mdl, 'def1', 'Aggregate', 'hk');
+            testcase.setSignalAttributes(other, 'def1', 'Aggregate', 'hk');
+            
+            testcase.verifyThat(@() testcase.generateCode(), IssuesNoWarnings);                
+            rtwbuild(other, 'ForceTopModelBuild', true);
+            
+            patterns(1).FileName = [mdl '_tlm_aggregate.h'];          
+            patterns(1).ContainsOrderedStrings = { ...           
+                '} ECI_AggDir_t;', ...
+                ['} ' mdl '_hk_Agg_t;'] }   ;         
+            patterns(2).FileName = [mdl '_eci_interface.h'];          
+            patterns(2).ContainsOrderedStrings = { ...           
+                ['#include "' mdl '_tlm_aggregate.h"'], ...
+                ['static ' mdl '_hk_Agg_t ' mdl '_hk_agg = { {0}, 1, 0, {'], ...
+                ['{ HK_AGG_MID, &' mdl '_hk_agg, sizeof(' mdl '_hk_Agg_t), NULL, NULL },'] }   ;         
+            testcase.checkCodeContents(patterns);
+            
+            folder = testcase.workingFixture.Folder;
+            src    = fullfile(folder, 'eci_aggregate_pair.c');
+            fid    = fopen(src, 'w');
+            fprintf(fid, '#include "%s_eci_interface.h"\n', mdl);
+            fprintf(fid, '#include "%s_eci_interface.h"\n', other);
+            fclose(fid);
+            
+            testcase.verifyThat(@() mex('-c', ...
+                ['-I' fullfile(folder, [mdl '_cfs_ert_rtw'])], ...
+                ['-I' fullfile(folder, [other '_cfs_ert_rtw'])], ...
+                ['-I' fileparts(which('eci_app.h'))], src), IssuesNoWarnings);
+        end        
+
     end
 end
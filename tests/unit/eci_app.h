@@ -53,6 +53,26 @@ extern "C"
 #define INBUS_MSG_IN4_MID          21
 #define INBUS_MSG_IN5_MID
 
+/* Native data types of Event data inputs (see ECI_Evs_t dataTypes) */
+#define ECI_EVENT_DATA_NONE      0
+#define ECI_EVENT_DATA_DOUBLE    1
+#define ECI_EVENT_DATA_SINGLE    2
+#define ECI_EVENT_DATA_INT8      3
+#define ECI_EVENT_DATA_UINT8     4
+#define ECI_EVENT_DATA_INT16     5
+#define ECI_EVENT_DATA_UINT16    6
+#define ECI_EVENT_DATA_INT32     7
+#define ECI_EVENT_DATA_UINT32    8
+#define ECI_EVENT_DATA_BOOLEAN   9
+
+/* Pack the types of the five Event data inputs, 4 bits each (data_1 in LSBs) */
+#define ECI_EVENT_DATA_DESC(t1, t2, t3, t4, t5) \
+    ((uint32_T)(t1) | ((uint32_T)(t2) << 4) | ((uint32_T)(t3) << 8) | \
+     ((uint32_T)(t4) << 12) | ((uint32_T)(t5) << 16))
+
+/* Type of Event data input n (1-5) from a packed descriptor */
+#define ECI_EVENT_DATA_TYPE(desc, n)  (((desc) >> (4*((n)-1))) & 0xFU)
+
 #define QUEUE_SIZE 20
 #define CMD_MSG_QUEUE_SIZE 20
 
@@ -77,6 +97,59 @@ typedef struct {
                                 Output Buffer Msg on SB - Don't Care for Input Messages */
 } ECI_Msg_t;
 
+/* Received Message Function-call Entry Point Structure (export-function models) */
+typedef struct {
+   uint8_T     mid;     /* Message ID */
+   ECI_Msg_t   *msg;    /* ECI_MsgRcv entry the message is copied to */
+   void        (*fcn)(void); /* Entry point to call on message arrival */
+} ECI_MsgFcn_t;
+
+/* Batched Command Input Structure */
+typedef struct {
+   uint8_T     mid;      /* Message ID */
+   ECI_Msg_t   *msg;     /* ECI_MsgRcv entry, mptr is the first element of the input array */
+   uint32_T    capacity; /* Elements in the input array */
+   uint32_T    *count;   /* Count input, commands delivered this step */
+} ECI_CmdBatch_t;
+
+/* Command Priority Lane Structure */
+typedef struct {
+   uint32_T    priority;   /* Priority of the lane's commands, higher serviced first */
+   void        *slots;     /* depth command slots of slotSize bytes */
+   size_t      slotSize;   /* Size of a slot, the largest command of the lane */
+   const ECI_Msg_t **msgs; /* ECI_MsgRcv entry of the command in each slot */
+   uint16_T    depth;      /* Slots in the lane */
+   uint16_T    dropOldest; /* Full lane: 1 drops the oldest command, 0 the received one */
+   uint16_T    *head;      /* Slot of the oldest command */
+   uint16_T    *count;     /* Commands queued */
+   uint32_T    *dropped;   /* Commands dropped because the lane was full */
+} ECI_CmdLane_t;
+
+/* Command Priority Lane Map Structure */
+typedef struct {
+   uint8_T     mid;        /* Message ID */
+   ECI_Msg_t   *msg;       /* ECI_MsgRcv entry of the command input */
+   const ECI_CmdLane_t *lane; /* Lane the command is queued in */
+} ECI_CmdLaneMap_t;
+
+/* Buffered Telemetry Input Structure */
+typedef struct {
+   uint8_T     mid;      /* Message ID */
+   ECI_Msg_t   *msg;     /* ECI_MsgRcv entry, mptr is the first element of the input array */
+   uint32_T    capacity; /* Elements in the input array */
+   uint32_T    *count;   /* Count input, samples received since the last step */
+   real_T      *times;   /* Arrival time input (s) of each sample, NULL if none */
+} ECI_TlmSamples_t;
+
+/* Multitasking Partition Task Structure */
+typedef struct {
+   char*       name;        /* Child task name */
+   void        (*fcn)(void); /* Step entry point of the task's sample rate */
+   uint32_T    periodTicks; /* Period in base rate (ECI_TICK_MID) ticks */
+   int32_T     core;        /* CPU core to pin the task to, -1 = any */
+   uint32_T    priorityOffset; /* Priority below the app main task */
+} ECI_Task_t;
+
 /* FDC Reporting Interface Structure */
 typedef struct {
   uint8_T    *   FlagID;     /* Pointer to Flag Id  - unique id set by the user */
@@ -90,15 +163,31 @@ typedef struct {
   uint8_T    * eventType;   /* Event Type - debug, info, error, crit set by user */
   uint32_T* eventMask;  /* Event Mask - filter set by user */
   boolean_T* eventFlag; /* Flag indicating simulink event has occurred */
+  uint32_T* suppCount;  /* Count of events dropped by the block rate limit */
   uint8_T    * eventMsg;    /* Msgpoint to send with an event taken from observable signal */     
   char* loc;          /* Location string */
-  double* data_1;     /* First data point */
-  double* data_2;     /* Second data point */
-  double* data_3;     /* Third data point */
-  double* data_4;     /* Fourth data point */
-  double* data_5;     /* Fifth data point */
+  uint32_T dataTypes; /* Data point types - see ECI_EVENT_DATA_DESC */
+  const void* data_1; /* First data point */
+  const void* data_2; /* Second data point */
+  const void* data_3; /* Third data point */
+  const void* data_4; /* Fourth data point */
+  const void* data_5; /* Fifth data point */
 } ECI_Evs_t;
 
+/* Compact EVS Interface Structure (ECI_EVENT_TABLE_COMPACT) */
+typedef struct {
+  boolean_T* eventFlag; /* Flag indicating simulink event has occurred */
+  uint32_T* suppCount;  /* Count of events dropped by the block rate limit */
+  uint32_T eventMask;   /* Event Mask - filter set by user */
+  uint32_T dataTypes;   /* Data point types - see ECI_EVENT_DATA_DESC */
+  uint32_T loc;         /* Location: ECI_EventStr offset, or path ID if ECI_EVENT_LOC_HASHED */
+  uint16_T eventMsg;    /* Format string: ECI_EventStr offset */
+  uint16_T dataIdx;     /* First data point in ECI_EventData */
+  uint8_T  eventID;     /* Event Id  - unique id set by the user*/
+  uint8_T  eventType;   /* Event Type - debug, info, error, crit set by user */
+  uint8_T  eventBlock;  /* Event Block describes how many data points  */
+} ECI_EvsCompact_t;
+
 /* Table Interface Structure */
 typedef struct{
     void**  tblptr;       /* Pointer to table  */
@@ -117,6 +206,38 @@ typedef struct
    void*  cdsptr;          /* Address of Critical Data  */
 }ECI_Cds_t;
 
+/* Model Registration Structure (namespaced interface, <model>_ECI_Model) */
+typedef struct
+{
+   const char*   name;           /* Model name, lower case */
+   const char*   cmdPipeName;    /* Pipe names of the model's own app */
+   const char*   dataPipeName;
+   real_T        basePeriod;     /* Base rate step size, seconds */
+   uint32_T      cmdMid;         /* Message IDs of the model (ECI_CMD_MID, ...) */
+   uint32_T      tickMid;
+   uint32_T      hkMid;
+   uint32_T      flagMid;
+   uint32_T      perfId;
+   void          (*init)(void);  /* ECI_INIT_FCN */
+   void          (*step)(void);  /* Command lane service, ECI_STEP_FCN, batch and sample clear */
+   void          (*term)(void);  /* ECI_TERM_FCN */
+   int           (*deliver)(uint32_T mid, const void* msg, size_t size, real_T time);
+                                 /* Queues, batches or buffers a received message, 0 to copy it to msgRcv */
+   ECI_Msg_t*    msgRcv;         /* ECI_MsgRcv */
+   ECI_Msg_t*    msgSnd;         /* ECI_MsgSnd */
+   const ECI_MsgFcn_t* msgFcn;   /* ECI_MsgFcn, NULL if none */
+   const void*   events;         /* ECI_Events, NULL if none */
+   uint32_T      eventsCompact;  /* events are ECI_EvsCompact_t (ECI_EVENT_TABLE_COMPACT) */
+   const char*   eventStr;       /* ECI_EventStr of compact events, NULL if none */
+   const void* const* eventData; /* ECI_EventData of compact events, NULL if none */
+   const ECI_Flag_t* flags;      /* ECI_Flags, NULL if none */
+   ECI_Tbl_t*    params;         /* ECI_ParamTable, NULL if none */
+   const ECI_Cds_t* cds;         /* ECI_CdsTable, NULL if none */
+   const ECI_Task_t* tasks;      /* ECI_Tasks, NULL if none */
+   int           (*warmInit)(void); /* ECI_WARM_INIT_FCN, 1 for a warm start, NULL if none */
+   const ECI_Cds_t* warm;        /* ECI_WarmTable, NULL if none */
+} ECI_Model_t;
+
 /* Added from cfe_time.h for stubbing */
 typedef struct
 {
@@ -127,6 +248,10 @@ typedef struct
 /* Time Interface Structure */
 typedef CFE_TIME_SysTime_t ECI_TimeStamp_t;
 
+/* cFE performance log markers (SIL Perf Marker block), stubbed */
+#define ECI_PERF_ENTRY(id)  ((void)(id))
+#define ECI_PERF_EXIT(id)   ((void)(id))
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
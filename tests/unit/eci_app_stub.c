@@ -2,4 +2,5 @@
 #include "eci_app.h"
 
 ECI_TimeStamp_t ECI_Step_TimeStamp = {0,0};
+real_T ECI_Step_Time = 0.0;
 